@@ -0,0 +1,180 @@
+#include "benchmarkHarness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+BenchmarkHarness::BenchmarkHarness(const size_t &minimal_iterations_number, const double &minimal_time_s,
+                                   const size_t &maximal_iterations_number)
+  : minimal_iterations_number_(minimal_iterations_number), minimal_time_s_(minimal_time_s),
+    maximal_iterations_number_(maximal_iterations_number) {}
+
+void BenchmarkHarness::SetFilter(const std::string &filter) {
+  /** Sets the filter of cases. Only cases with names containing the filter are run.
+   * @brief Sets the filter of cases.
+   */
+  filter_ = filter;
+}
+
+bool BenchmarkHarness::ShouldRun(const std::string &name) const {
+  return filter_.empty() || name.find(filter_) != std::string::npos;
+}
+
+BenchmarkResult *BenchmarkHarness::Run(const std::string &name, const std::string &parameters,
+                                       const std::function<void()> &iteration) {
+  /** Runs the case and stores its result.
+   * @brief Runs the case and stores its result.
+   * @param name - Name of the case.
+   * @param parameters - Parameters of the case, in "key=value;key=value" form.
+   * @param iteration - Callable performing single iteration.
+   * @return Pointer to the stored result or nullptr if case was filtered out. It's valid until next result is
+   * added.
+   */
+  if(!ShouldRun(name)) {
+    return nullptr;
+  }
+
+  // Warm-up.
+  iteration();
+
+  std::vector<double> durations_us = {};
+  double total_time_s = 0;
+
+  while(durations_us.size() < maximal_iterations_number_ &&
+        (durations_us.size() < minimal_iterations_number_ || total_time_s < minimal_time_s_)) {
+    auto start = std::chrono::steady_clock::now();
+    iteration();
+    auto duration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+    durations_us.push_back(duration.count());
+    total_time_s += duration.count() / 1e6;
+  }
+
+  AddResult(SummarizeDurations(name, parameters, durations_us));
+
+  return &results_.back();
+}
+
+void BenchmarkHarness::AddResult(const BenchmarkResult &result) {
+  results_.push_back(result);
+}
+
+const std::vector<BenchmarkResult> &BenchmarkHarness::GetResults() const {
+  return results_;
+}
+
+void BenchmarkHarness::WriteJSON(std::ostream &output) const {
+  /** Writes results as JSON array of cases. Durations are in microseconds.
+   * @brief Writes results as JSON array of cases.
+   */
+  output << "[\n";
+
+  for(size_t i = 0; i < results_.size(); ++i) {
+    const auto &result = results_[i];
+
+    output << "  {\"name\": \"" << EscapeJSON(result.name_) << "\", "
+           << "\"parameters\": \"" << EscapeJSON(result.parameters_) << "\", "
+           << "\"iterations\": " << result.iterations_ << ", "
+           << "\"mean_us\": " << result.mean_us_ << ", "
+           << "\"median_us\": " << result.median_us_ << ", "
+           << "\"min_us\": " << result.min_us_ << ", "
+           << "\"max_us\": " << result.max_us_ << ", "
+           << "\"std_dev_us\": " << result.std_dev_us_;
+
+    for(const auto &counter : result.counters_) {
+      output << ", \"" << EscapeJSON(counter.first) << "\": " << counter.second;
+    }
+
+    output << "}" << (i + 1 == results_.size() ? "\n" : ",\n");
+  }
+
+  output << "]\n";
+}
+
+void BenchmarkHarness::WriteCSV(std::ostream &output) const {
+  /** Writes results as CSV, one case per row. Counters are written as "key=value" pairs in the last column, as
+   * they differ between the cases.
+   * @brief Writes results as CSV, one case per row.
+   */
+  output << "name,parameters,iterations,mean_us,median_us,min_us,max_us,std_dev_us,counters\n";
+
+  for(const auto &result : results_) {
+    output << result.name_ << "," << result.parameters_ << "," << result.iterations_ << ","
+           << result.mean_us_ << "," << result.median_us_ << "," << result.min_us_ << ","
+           << result.max_us_ << "," << result.std_dev_us_ << ",";
+
+    for(size_t i = 0; i < result.counters_.size(); ++i) {
+      output << (i == 0 ? "" : ";") << result.counters_[i].first << "=" << result.counters_[i].second;
+    }
+
+    output << "\n";
+  }
+}
+
+BenchmarkResult BenchmarkHarness::SummarizeDurations(const std::string &name, const std::string &parameters,
+                                                     std::vector<double> durations_us) {
+  /** Computes statistics of given durations.
+   * @brief Computes statistics of given durations.
+   */
+  BenchmarkResult result;
+  result.name_ = name;
+  result.parameters_ = parameters;
+  result.iterations_ = durations_us.size();
+
+  if(durations_us.empty()) {
+    return result;
+  }
+
+  std::sort(durations_us.begin(), durations_us.end());
+
+  double sum = 0;
+
+  for(auto duration : durations_us) {
+    sum += duration;
+  }
+
+  result.mean_us_ = sum / durations_us.size();
+
+  double squared_deviations_sum = 0;
+
+  for(auto duration : durations_us) {
+    squared_deviations_sum += (duration - result.mean_us_) * (duration - result.mean_us_);
+  }
+
+  result.std_dev_us_ = durations_us.size() > 1 ? sqrt(squared_deviations_sum / (durations_us.size() - 1)) : 0;
+  result.median_us_ = GetPercentile(durations_us, 50);
+  result.min_us_ = durations_us.front();
+  result.max_us_ = durations_us.back();
+
+  return result;
+}
+
+double BenchmarkHarness::GetPercentile(const std::vector<double> &sorted_values, const double &percentile) {
+  /** Returns the percentile of sorted values, using linear interpolation between closest ranks.
+   * @brief Returns the percentile of sorted values.
+   */
+  if(sorted_values.empty()) {
+    return 0;
+  }
+
+  double position = percentile / 100.0 * (sorted_values.size() - 1);
+  size_t lower_index = static_cast<size_t>(floor(position));
+  size_t upper_index = std::min(lower_index + 1, sorted_values.size() - 1);
+  double fraction = position - lower_index;
+
+  return sorted_values[lower_index] + fraction * (sorted_values[upper_index] - sorted_values[lower_index]);
+}
+
+std::string BenchmarkHarness::EscapeJSON(const std::string &text) {
+  std::string escaped_text = "";
+
+  for(auto character : text) {
+    if(character == '"' || character == '\\') {
+      escaped_text += '\\';
+    }
+
+    escaped_text += character;
+  }
+
+  return escaped_text;
+}
@@ -0,0 +1,58 @@
+#ifndef KERDEP_BENCHMARKHARNESS_H
+#define KERDEP_BENCHMARKHARNESS_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct BenchmarkResult {
+  std::string name_ = "";
+  std::string parameters_ = "";
+  size_t iterations_ = 0;
+  double mean_us_ = 0;
+  double median_us_ = 0;
+  double min_us_ = 0;
+  double max_us_ = 0;
+  double std_dev_us_ = 0;
+  // Additional, case-specific values, e.g. processed elements per second.
+  std::vector<std::pair<std::string, double>> counters_ = {};
+};
+
+class BenchmarkHarness {
+
+    /** Minimal harness for parameterized benchmark cases. Each case is a callable performing one iteration. The
+     * harness runs one warm-up iteration, then repeats the case until both minimal iterations number and minimal
+     * time are reached, timing every iteration separately. Results can be written as JSON or CSV.
+     *
+     * @brief Minimal harness for parameterized benchmark cases.
+     */
+  public:
+    BenchmarkHarness(const size_t &minimal_iterations_number = 10, const double &minimal_time_s = 0.5,
+                     const size_t &maximal_iterations_number = 100000);
+
+    void SetFilter(const std::string &filter);
+    bool ShouldRun(const std::string &name) const;
+    BenchmarkResult *Run(const std::string &name, const std::string &parameters, const std::function<void()> &iteration);
+    void AddResult(const BenchmarkResult &result);
+    const std::vector<BenchmarkResult> &GetResults() const;
+
+    void WriteJSON(std::ostream &output) const;
+    void WriteCSV(std::ostream &output) const;
+
+    static BenchmarkResult SummarizeDurations(const std::string &name, const std::string &parameters,
+                                              std::vector<double> durations_us);
+    static double GetPercentile(const std::vector<double> &sorted_values, const double &percentile);
+
+  protected:
+    size_t minimal_iterations_number_ = 10;
+    double minimal_time_s_ = 0.5;
+    size_t maximal_iterations_number_ = 100000;
+    std::string filter_ = "";
+    std::vector<BenchmarkResult> results_ = {};
+
+    static std::string EscapeJSON(const std::string &text);
+};
+
+#endif //KERDEP_BENCHMARKHARNESS_H
@@ -0,0 +1,160 @@
+#include "benchmarkStream.h"
+
+#include <cstdlib>
+
+#include "../Distributions/complexdistribution.h"
+#include "../Distributions/normaldistribution.h"
+#include "../Reservoir_sampling/basicReservoirSamplingAlgorithm.h"
+
+BenchmarkStream::BenchmarkStream(const int &seed, const double &progression_size, const double &max_mean)
+  : seed_(seed) {
+  srand(static_cast<unsigned int>(seed));
+
+  means_.push_back(std::make_shared<std::vector<double>>(1, 0.0));
+  standard_deviations_.push_back(std::make_shared<std::vector<double>>(1, 1.0));
+  contributions_.push_back(100.0);
+
+  std::vector<std::shared_ptr<distribution>> elemental_distributions = {};
+
+  for(size_t i = 0; i < means_.size(); ++i) {
+    elemental_distributions.push_back(std::shared_ptr<distribution>(
+        new normalDistribution(seed, means_[i].get(), standard_deviations_[i].get(), max_mean)));
+  }
+
+  target_distribution_.reset(new complexDistribution(seed, &elemental_distributions, &contributions_));
+
+  parser_.reset(new distributionDataParser(&attributes_data_));
+  reader_.reset(new progressiveDistributionDataReader(target_distribution_.get(), progression_size, 0,
+                                                      new normalDistribution(seed, &alternative_distribution_mean_,
+                                                                             &alternative_distribution_standard_deviation_,
+                                                                             max_mean)));
+
+  reader_->gatherAttributesData(&attributes_data_);
+  parser_->setAttributesOrder(reader_->getAttributesOrder());
+}
+
+std::shared_ptr<sample> BenchmarkStream::GetNextObject() {
+  /** Reads next datum of the stream and parses it into new object, the same way reservoir sampling does.
+   * @brief Reads next datum of the stream and parses it into new object.
+   */
+  std::vector<std::shared_ptr<sample>> container = {};
+
+  reader_->getNextRawDatum(parser_->buffer);
+  parser_->addDatumToContainer(&container);
+  parser_->writeDatumOnPosition(&container, 0);
+
+  ++objects_number_;
+
+  return container.back();
+}
+
+std::vector<std::shared_ptr<sample>> BenchmarkStream::GenerateObjects(const size_t &objects_number) {
+  std::vector<std::shared_ptr<sample>> objects = {};
+
+  for(size_t i = 0; i < objects_number; ++i) {
+    objects.push_back(GetNextObject());
+  }
+
+  return objects;
+}
+
+std::vector<std::shared_ptr<cluster>> BenchmarkStream::GenerateClusters(const size_t &clusters_number) {
+  /** Generates clusters the way DESDA does, i.e. one per object, with object number as id and timestamp. Newest
+   * clusters are first.
+   * @brief Generates clusters the way DESDA does.
+   */
+  std::vector<std::shared_ptr<cluster>> clusters = {};
+
+  for(size_t i = 0; i < clusters_number; ++i) {
+    auto object = GetNextObject();
+    auto new_cluster = std::make_shared<cluster>(cluster(objects_number_, object));
+    new_cluster->setTimestamp(objects_number_);
+    clusters.insert(clusters.begin(), new_cluster);
+  }
+
+  return clusters;
+}
+
+std::vector<double> BenchmarkStream::GenerateValues(const size_t &values_number) {
+  /** Generates values of the first attribute of consecutive objects. It's meant for estimators that work on raw,
+   * one dimensional values, like wavelet ones.
+   * @brief Generates values of the first attribute of consecutive objects.
+   */
+  std::vector<double> values = {};
+  std::string attribute_name = reader_->getAttributesOrder()->front();
+
+  for(size_t i = 0; i < values_number; ++i) {
+    values.push_back(std::stod(GetNextObject()->attributesValues[attribute_name]));
+  }
+
+  return values;
+}
+
+std::vector<std::vector<double>> BenchmarkStream::GenerateRawData(const size_t &data_number,
+                                                                  std::vector<std::vector<double>> *means_history) {
+  /** Generates raw data of the stream, without parsing it into objects. As reader moves the means of the target
+   * distribution, means of all the components are stored after each datum, so that the model can be recreated for
+   * any step when the data is replayed.
+   * @brief Generates raw data of the stream along with the means of the model.
+   * @param data_number - Number of data to generate.
+   * @param means_history - Target for flattened means of the components after each datum. Can be nullptr.
+   * @return Generated data.
+   */
+  std::vector<std::vector<double>> data = {};
+  std::vector<double> datum = {};
+
+  for(size_t i = 0; i < data_number; ++i) {
+    reader_->getNextRawDatum(&datum);
+    data.push_back(datum);
+
+    if(means_history == nullptr) {
+      continue;
+    }
+
+    means_history->push_back({});
+
+    for(const auto &component_means : means_) {
+      means_history->back().insert(means_history->back().end(), component_means->begin(), component_means->end());
+    }
+  }
+
+  return data;
+}
+
+reservoirSamplingAlgorithm *BenchmarkStream::CreateReservoirSamplingAlgorithm(const int &sample_size,
+                                                                              const int &steps_number) {
+  return new basicReservoirSamplingAlgorithm(reader_.get(), parser_.get(), sample_size, steps_number);
+}
+
+std::shared_ptr<dataParser> BenchmarkStream::GetParser() const {
+  return parser_;
+}
+
+std::unordered_map<std::string, attributeData *> *BenchmarkStream::GetAttributesData() {
+  return &attributes_data_;
+}
+
+std::vector<std::shared_ptr<std::vector<double>>> *BenchmarkStream::GetMeans() {
+  return &means_;
+}
+
+std::vector<std::shared_ptr<std::vector<double>>> *BenchmarkStream::GetStandardDeviations() {
+  return &standard_deviations_;
+}
+
+std::vector<double> *BenchmarkStream::GetContributions() {
+  return &contributions_;
+}
+
+kernelDensityEstimator *BenchmarkStream::CreateKernelDensityEstimator(const double &smoothing_parameter) {
+  /** Creates one dimensional KDE with normal kernel, as used in the experiments.
+   * @brief Creates one dimensional KDE with normal kernel.
+   */
+  std::vector<std::shared_ptr<std::vector<double>>> samples = {};
+  std::vector<double> smoothing_parameters = {smoothing_parameter};
+  std::vector<std::string> carriers_restrictions = {"None."};
+  std::vector<int> kernels_ids = {0}; // Normal kernel.
+
+  return new kernelDensityEstimator(&samples, &smoothing_parameters, &carriers_restrictions, PRODUCT,
+                                    &kernels_ids);
+}
@@ -0,0 +1,65 @@
+#ifndef KERDEP_BENCHMARKSTREAM_H
+#define KERDEP_BENCHMARKSTREAM_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../Distributions/distribution.h"
+#include "../KDE/kerneldensityestimator.h"
+#include "../Reservoir_sampling/distributiondataparser.h"
+#include "../Reservoir_sampling/progressivedistributiondatareader.h"
+#include "../Reservoir_sampling/reservoirSamplingAlgorithm.h"
+#include "../groupingThread/kMedoidsAlgorithm/attributeData.h"
+#include "../groupingThread/kMedoidsAlgorithm/groupingAlgorithm/cluster.h"
+
+class BenchmarkStream {
+
+    /** Headless counterpart of the stream used in the DESDA experiments. It builds the same target distribution,
+     * parser and progressive reader as the main window does for its default settings (one normal component, drifting
+     * with given progression), so that benchmarks work on data with the same characteristics as the experiments.
+     * Objects are owned by the stream, hence it has to outlive everything that uses them.
+     *
+     * @brief Headless counterpart of the stream used in the DESDA experiments.
+     */
+  public:
+    explicit BenchmarkStream(const int &seed = 5625, const double &progression_size = 0.01,
+                             const double &max_mean = 55);
+
+    BenchmarkStream(const BenchmarkStream &) = delete;
+    BenchmarkStream &operator=(const BenchmarkStream &) = delete;
+
+    std::shared_ptr<sample> GetNextObject();
+    std::vector<std::shared_ptr<sample>> GenerateObjects(const size_t &objects_number);
+    std::vector<std::shared_ptr<cluster>> GenerateClusters(const size_t &clusters_number);
+    std::vector<double> GenerateValues(const size_t &values_number);
+    std::vector<std::vector<double>> GenerateRawData(const size_t &data_number,
+                                                     std::vector<std::vector<double>> *means_history);
+    reservoirSamplingAlgorithm *CreateReservoirSamplingAlgorithm(const int &sample_size, const int &steps_number);
+
+    std::shared_ptr<dataParser> GetParser() const;
+    std::unordered_map<std::string, attributeData *> *GetAttributesData();
+    std::vector<std::shared_ptr<std::vector<double>>> *GetMeans();
+    std::vector<std::shared_ptr<std::vector<double>>> *GetStandardDeviations();
+    std::vector<double> *GetContributions();
+
+    static kernelDensityEstimator *CreateKernelDensityEstimator(const double &smoothing_parameter = 1.0);
+
+  protected:
+    int seed_ = 5625;
+    int objects_number_ = 0;
+
+    std::vector<std::shared_ptr<std::vector<double>>> means_ = {};
+    std::vector<std::shared_ptr<std::vector<double>>> standard_deviations_ = {};
+    std::vector<double> contributions_ = {};
+    std::vector<double> alternative_distribution_mean_ = {0.0};
+    std::vector<double> alternative_distribution_standard_deviation_ = {1.0};
+
+    std::unordered_map<std::string, attributeData *> attributes_data_ = {};
+    std::shared_ptr<distribution> target_distribution_;
+    std::shared_ptr<dataParser> parser_;
+    std::shared_ptr<progressiveDistributionDataReader> reader_;
+};
+
+#endif //KERDEP_BENCHMARKSTREAM_H
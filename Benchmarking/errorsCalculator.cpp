@@ -6,87 +6,283 @@ ErrorsCalculator::ErrorsCalculator(std::vector<double> *model_function_values,
                                    std::vector<double> *estimator_values,
                                    std::vector<
                                        std::vector<double>> *error_domain,
-                                   double *domain_quantity)
+                                   double *domain_quantity,
+                                   const QuadratureRule &quadrature_rule)
  : model_function_values_(model_function_values),
    estimator_values_(estimator_values), error_domain_(error_domain),
-   domain_quantity_(domain_quantity)
+   domain_quantity_(domain_quantity), quadrature_rule_(quadrature_rule)
 {}
 
 double ErrorsCalculator::CalculateL1Error() {
   /** This method calculates l1 error between estimated values and model values.
    * @brief This method calculates l1 error between estimated values and model values.
    */
-  // Require that # of model and estimated values are equal.
-  if(model_function_values_->size() != estimator_values_->size()){
-    return -1;
-  }
-  // First calculate sum of absolute values of differences between estimations and model on the domain.
-  double sum_of_absolute_differences = 0;
-  for(auto i = 0; i < model_function_values_->size(); ++i){
-    sum_of_absolute_differences += fabs((*model_function_values_)[i] - (*estimator_values_)[i]);
-  }
-  // Then, get its average.
-  auto average_of_absolute_differences = sum_of_absolute_differences / model_function_values_->size();
-  // Finally multiply it by domains length, area or so...
-  return average_of_absolute_differences * *domain_quantity_;
+  return CalculateErrors().l1_;
 }
 
 double ErrorsCalculator::CalculateL2Error() {
   /** This method calculates l2 error between estimated values and model values.
    * @brief This method calculates l2 error between estimated values and model values.
    */
-  // Require that # of model and estimated values are equal.
-  if(model_function_values_->size() != estimator_values_->size()){
-    return -1;
-  }
-  // First calculate sum of squared values of differences between estimations and model on the domain.
-  double sum_of_absolute_differences = 0;
-  for(auto i = 0; i < model_function_values_->size(); ++i){
-    sum_of_absolute_differences += pow((*model_function_values_)[i] - (*estimator_values_)[i], 2);
-  }
-  // Then, get its average.
-  auto average_of_absolute_differences = sum_of_absolute_differences / model_function_values_->size();
-  // Finally multiply it by domains length, area or so, and square it all.
-  return pow(average_of_absolute_differences * *domain_quantity_, 0.5); // According to PK mail
+  return CalculateErrors().l2_;
 }
 
 double ErrorsCalculator::CalculateSupError() {
   /** This method calculates sup error between estimated values and model values.
    * @brief This method calculates sup error between estimated values and model values.
    */
+  return CalculateErrors().sup_;
+}
 
-  // Initialize the sup.
-  double sup = fabs((*model_function_values_)[0] - (*estimator_values_)[0]);
+double ErrorsCalculator::CalculateModError() {
+  /** Calculates mod error between model and estimated values.
+   * @brief Calculates mod error between model and estimated values.
+   */
+  return CalculateErrors().mod_;
+}
 
-  // Find the greatest absolute difference.
-  for(int i = 0; i < model_function_values_->size(); ++i) {
-    double new_sup = fabs((*model_function_values_)[i] - (*estimator_values_)[i]);
-    sup = new_sup > sup ? new_sup : sup;
+Errors ErrorsCalculator::CalculateErrors() {
+  /** Calculates L1, L2, sup and mod errors in a single pass over model and estimator values. Integrals are
+   * approximated with selected quadrature rule.
+   * @brief Calculates all errors in a single pass over model and estimator values.
+   * @return Calculated errors. Each of them is -1, if values and domain sizes differ.
+   */
+  // Require that # of model and estimated values are equal to the # of domain points.
+  if(!AreValuesConsistentWithDomain()) {
+    return Errors();
   }
 
-  // Return it.
-  return sup;
+  int model_max_value_index = -1;
+  return CalculateErrors(GetQuadratureWeights(), &model_max_value_index);
 }
 
-double ErrorsCalculator::CalculateModError() {
-  /** Calculates mod error between model and estimated values.
-   * @brief Calculates mod error between model and estimated values.
+std::vector<Errors> ErrorsCalculator::CalculateErrors(const std::vector<ErrorsCalculator *> &errors_calculators) {
+  /** Calculates errors of each given calculator. Calculators sharing the domain and model values reuse the
+   * quadrature weights and the position of model maximum found by the first of them.
+   * @brief Calculates errors of each given calculator.
+   * @param errors_calculators - Calculators to compute errors of.
+   * @return Errors of the calculators, in the same order.
    */
-  // Ensure, that both estimated and model values have the same dimension
-  // as domain. In this case return -1.
-  if( error_domain_->size() != estimator_values_->size() ||
-      error_domain_->size() != model_function_values_->size()){
-    return -1;
+  std::vector<Errors> errors = {};
+  std::vector<int> model_max_values_indices = {};
+  errors.reserve(errors_calculators.size());
+  model_max_values_indices.reserve(errors_calculators.size());
+
+  for(size_t i = 0; i < errors_calculators.size(); ++i) {
+    auto calculator = errors_calculators[i];
+    int model_max_value_index = -1;
+
+    if(!calculator->AreValuesConsistentWithDomain()) {
+      errors.emplace_back();
+      model_max_values_indices.push_back(model_max_value_index);
+      continue;
+    }
+
+    // Find calculator, that already did the same work.
+    const std::vector<double> *quadrature_weights = nullptr;
+
+    for(size_t j = 0; j < i; ++j) {
+      auto other = errors_calculators[j];
+
+      if(model_max_values_indices[j] >= 0 && other->error_domain_ == calculator->error_domain_
+         && other->domain_quantity_ == calculator->domain_quantity_
+         && other->quadrature_rule_ == calculator->quadrature_rule_
+         && other->model_function_values_ == calculator->model_function_values_) {
+        quadrature_weights = &other->GetQuadratureWeights();
+        model_max_value_index = model_max_values_indices[j];
+        break;
+      }
+    }
+
+    if(quadrature_weights == nullptr) {
+      quadrature_weights = &calculator->GetQuadratureWeights();
+    }
+
+    errors.push_back(calculator->CalculateErrors(*quadrature_weights, &model_max_value_index));
+    model_max_values_indices.push_back(model_max_value_index);
+  }
+
+  return errors;
+}
+
+void ErrorsCalculator::SetQuadratureRule(const QuadratureRule &quadrature_rule) {
+  /** Sets the quadrature rule used to approximate L1 and L2 integrals.
+   * @brief Sets the quadrature rule used to approximate L1 and L2 integrals.
+   */
+  quadrature_rule_ = quadrature_rule;
+  quadrature_weights_domain_size_ = 0;
+}
+
+Errors ErrorsCalculator::CalculateErrors(const std::vector<double> &quadrature_weights, int *model_max_value_index) {
+  /** Fused pass computing all of the errors. It requires that values are consistent with domain.
+   * @brief Fused pass computing all of the errors.
+   * @param quadrature_weights - Weights of the quadrature on error domain.
+   * @param model_max_value_index - Index of model maximum if it's known, -1 otherwise. It's set to the found
+   * index after the pass.
+   */
+  Errors errors;
+
+  const size_t values_number = model_function_values_->size();
+  const double *model_values = model_function_values_->data();
+  const double *estimator_values = estimator_values_->data();
+  const double *weights = quadrature_weights.data();
+
+  if(values_number == 0) {
+    return errors;
+  }
+
+  double weighted_absolute_differences_sum = 0;
+  double weighted_squared_differences_sum = 0;
+  double sup = 0;
+
+  int estimator_max_value_index = 0;
+  double estimator_max_value = estimator_values[0];
+  const bool should_find_model_max = *model_max_value_index < 0;
+  int model_max_index = should_find_model_max ? 0 : *model_max_value_index;
+  double model_max_value = model_values[model_max_index];
+
+  for(size_t i = 0; i < values_number; ++i) {
+    const double difference = model_values[i] - estimator_values[i];
+    const double absolute_difference = fabs(difference);
+
+    weighted_absolute_differences_sum += weights[i] * absolute_difference;
+    weighted_squared_differences_sum += weights[i] * difference * difference;
+    sup = absolute_difference > sup ? absolute_difference : sup;
+
+    if(estimator_max_value < estimator_values[i]) {
+      estimator_max_value = estimator_values[i];
+      estimator_max_value_index = i;
+    }
+
+    if(should_find_model_max && model_max_value < model_values[i]) {
+      model_max_value = model_values[i];
+      model_max_index = i;
+    }
+  }
+
+  *model_max_value_index = model_max_index;
+
+  errors.l1_ = weighted_absolute_differences_sum;
+  errors.l2_ = sqrt(weighted_squared_differences_sum); // According to PK mail
+  errors.sup_ = sup;
+  errors.mod_ = CalculateEuclideanDistance((*error_domain_)[model_max_index],
+                                           (*error_domain_)[estimator_max_value_index]);
+
+  return errors;
+}
+
+bool ErrorsCalculator::AreValuesConsistentWithDomain() const {
+  /** Checks if both estimated and model values have the same size as domain.
+   * @brief Checks if both estimated and model values have the same size as domain.
+   */
+  return error_domain_->size() == estimator_values_->size() &&
+         error_domain_->size() == model_function_values_->size();
+}
+
+const std::vector<double> &ErrorsCalculator::GetQuadratureWeights() {
+  /** Returns weights of the quadrature on the error domain. They are recomputed only if domain size or domain
+   * quantity has changed. For the rectangle rule, weights are equal to domain quantity divided by the number of
+   * points. Trapezoid and Simpson's rules are applied to 1D domains and, as tensor products, to 2D grids (with x
+   * changing in outer loop) which is the way 2D error domains are generated.
+   * @brief Returns weights of the quadrature on the error domain.
+   */
+  const size_t points_number = error_domain_->size();
+
+  if(quadrature_weights_domain_size_ == points_number &&
+     quadrature_weights_domain_quantity_ == *domain_quantity_ &&
+     quadrature_weights_.size() == points_number) {
+    return quadrature_weights_;
+  }
+
+  quadrature_weights_domain_size_ = points_number;
+  quadrature_weights_domain_quantity_ = *domain_quantity_;
+  quadrature_weights_.assign(points_number, *domain_quantity_ / points_number);
+
+  if(quadrature_rule_ == QuadratureRule::kRectangle || points_number < 2) {
+    return quadrature_weights_;
+  }
+
+  const size_t dimension = (*error_domain_)[0].size();
+
+  if(dimension == 1) {
+    quadrature_weights_ = Calculate1DQuadratureWeights(points_number, *domain_quantity_);
+    return quadrature_weights_;
+  }
+
+  if(dimension == 2) {
+    const size_t column_size = Find2DGridColumnSize();
+
+    // Fall back to the rectangle rule if domain isn't a full grid.
+    if(column_size < 2 || points_number % column_size != 0 || points_number / column_size < 2) {
+      return quadrature_weights_;
+    }
+
+    const size_t row_size = points_number / column_size;
+    const double x_length = error_domain_->back()[0] - (*error_domain_)[0][0];
+    const double y_length = error_domain_->back()[1] - (*error_domain_)[0][1];
+
+    // Scale both lengths so their product is equal to the given area.
+    const double scale = x_length * y_length == 0 ? 1 : sqrt(*domain_quantity_ / (x_length * y_length));
+    auto x_weights = Calculate1DQuadratureWeights(row_size, x_length * scale);
+    auto y_weights = Calculate1DQuadratureWeights(column_size, y_length * scale);
+
+    for(size_t i = 0; i < row_size; ++i) {
+      for(size_t j = 0; j < column_size; ++j) {
+        quadrature_weights_[i * column_size + j] = x_weights[i] * y_weights[j];
+      }
+    }
   }
-  // Find greatest value of model and estimated values.
-  auto max_model_value_index = FindMaxValueIndex(*model_function_values_);
-  auto max_estimator_value_index =
-      FindMaxValueIndex(*estimator_values_);
-  auto model_max_value_point = (*error_domain_)[max_model_value_index];
-  auto estimator_max_value_point = (*error_domain_)[max_estimator_value_index];
-  // Return distance between selected points.
-  return CalculateEuclideanDistance(model_max_value_point,
-                                    estimator_max_value_point);
+
+  return quadrature_weights_;
+}
+
+std::vector<double> ErrorsCalculator::Calculate1DQuadratureWeights(const size_t &points_number,
+                                                                   const double &length) const {
+  /** Calculates weights of trapezoid or Simpson's rule on uniformly spaced points. Simpson's rule requires even
+   * number of intervals. If it's odd, the last interval is integrated with the trapezoid rule.
+   * @brief Calculates weights of trapezoid or Simpson's rule on uniformly spaced points.
+   */
+  std::vector<double> weights(points_number, 0);
+  const double step = length / (points_number - 1);
+
+  if(quadrature_rule_ == QuadratureRule::kTrapezoid || points_number < 3) {
+    for(auto &weight : weights) {
+      weight = step;
+    }
+
+    weights.front() = step / 2;
+    weights.back() = step / 2;
+
+    return weights;
+  }
+
+  const size_t intervals_number = points_number - 1;
+  const size_t simpson_points_number = intervals_number % 2 == 0 ? points_number : points_number - 1;
+
+  for(size_t i = 0; i < simpson_points_number; ++i) {
+    weights[i] = (i == 0 || i == simpson_points_number - 1) ? step / 3 : (i % 2 == 1 ? 4 * step / 3 : 2 * step / 3);
+  }
+
+  if(simpson_points_number != points_number) {
+    weights[points_number - 2] += step / 2;
+    weights[points_number - 1] += step / 2;
+  }
+
+  return weights;
+}
+
+size_t ErrorsCalculator::Find2DGridColumnSize() const {
+  /** Finds the number of consecutive domain points with the same first coordinate.
+   * @brief Finds the number of consecutive domain points with the same first coordinate.
+   */
+  size_t column_size = 0;
+  const double first_x = (*error_domain_)[0][0];
+
+  while(column_size < error_domain_->size() && (*error_domain_)[column_size][0] == first_x) {
+    ++column_size;
+  }
+
+  return column_size;
 }
 
 double ErrorsCalculator::FindMaxValueIndex(const std::vector<double> &values) {
@@ -126,10 +322,10 @@ double ErrorsCalculator::CalculateEuclideanDistance(
   // Calculate sum of squares of differences between the points.
   double sum = 0;
   for(auto i = 0; i < point_2.size(); ++i){
-    sum += pow(point_1[i] - point_2[i], 2);
+    sum += (point_1[i] - point_2[i]) * (point_1[i] - point_2[i]);
   }
   // Return square root of this sum (the euclidean distance).
-  return pow(sum, 0.5);
+  return sqrt(sum);
 }
 
 
@@ -1,8 +1,22 @@
 #ifndef KERDEP_ERRORSCALCULATOR_H
 #define KERDEP_ERRORSCALCULATOR_H
 
+#include <cstddef>
 #include <vector>
 
+enum class QuadratureRule : int {
+  kRectangle = 0, // Average value times domain quantity. Used in all of the past experiments.
+  kTrapezoid = 1,
+  kSimpson = 2
+};
+
+struct Errors {
+  double l1_ = -1;
+  double l2_ = -1;
+  double sup_ = -1;
+  double mod_ = -1;
+};
+
 class ErrorsCalculator {
 
     /** Error calculator class is designed to calculate the usual notions of describing differences between two
@@ -15,17 +29,31 @@ class ErrorsCalculator {
     ErrorsCalculator(std::vector<double> *model_function_values,
                      std::vector<double> *estimator_values,
                      std::vector<std::vector<double>> *error_domain,
-                     double *domain_quantity);
+                     double *domain_quantity,
+                     const QuadratureRule &quadrature_rule = QuadratureRule::kRectangle);
     double CalculateL1Error();
     double CalculateL2Error();
     double CalculateSupError();
     double CalculateModError();
+    Errors CalculateErrors();
+    static std::vector<Errors> CalculateErrors(const std::vector<ErrorsCalculator *> &errors_calculators);
+    void SetQuadratureRule(const QuadratureRule &quadrature_rule);
   private:
     std::vector<double> *model_function_values_;
     std::vector<double> *estimator_values_;
     std::vector<std::vector<double>> *error_domain_;
     double *domain_quantity_; // For one dimension it should be length, in two it should be area, and so...
+    QuadratureRule quadrature_rule_ = QuadratureRule::kRectangle;
+
+    std::vector<double> quadrature_weights_ = {};
+    size_t quadrature_weights_domain_size_ = 0;
+    double quadrature_weights_domain_quantity_ = 0;
 
+    bool AreValuesConsistentWithDomain() const;
+    const std::vector<double> &GetQuadratureWeights();
+    Errors CalculateErrors(const std::vector<double> &quadrature_weights, int *model_max_value_index);
+    std::vector<double> Calculate1DQuadratureWeights(const size_t &points_number, const double &length) const;
+    size_t Find2DGridColumnSize() const;
     double FindMaxValueIndex(const std::vector<double> &values);
     double CalculateEuclideanDistance(const std::vector<double> &point_1, const std::vector<double> &point_2);
 };
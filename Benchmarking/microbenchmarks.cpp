@@ -0,0 +1,299 @@
+// Headless microbenchmarks of the numerical core. Every case is run on the data stream of the default DESDA
+// experiment, generated with fixed seed, so that timings of different builds are comparable.
+//
+// Usage: KerDEPBenchmarks [--filter=<substring>] [--format=json|csv] [--output=<path>] [--min-time=<seconds>]
+//                         [--seed=<seed>]
+// Results are written to the standard output, unless output path is given.
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmarkHarness.h"
+#include "benchmarkStream.h"
+#include "errorsCalculator.h"
+
+#include "../DESDA.h"
+#include "../Functions/cachednormalmixturedensityfunction.h"
+#include "../KDE/kerneldensityestimator.h"
+#include "../KDE/pluginsmoothingparametercounter.h"
+#include "../StationarityTests/kpssstationaritytest.h"
+#include "../groupingThread/kMeansAlgorithm.h"
+
+#include "../groupingThread/kMedoidsAlgorithm/customObjectsDistanceMeasure.h"
+#include "../groupingThread/kMedoidsAlgorithm/attributesDistanceMeasures/numerical/gowersNumericalAttributesDistanceMeasure.h"
+#include "../groupingThread/kMedoidsAlgorithm/attributesDistanceMeasures/categorical/smdCategoricalAttributesDistanceMeasure.h"
+#include "../groupingThread/kMedoidsAlgorithm/clusterDistanceMeasures/centroidLinkClusterDistanceMeasure.h"
+
+#include "LinearWDE.h"
+
+struct BenchmarkSettings {
+  std::string filter_ = "";
+  std::string format_ = "json";
+  std::string output_path_ = "";
+  double minimal_time_s_ = 0.5;
+  int seed_ = 5625;
+};
+
+void SilentMessageHandler(QtMsgType, const QMessageLogContext &, const QString &) {}
+
+std::vector<std::vector<double>> GenerateDomain(const double &min, const double &max, const size_t &points_number) {
+  std::vector<std::vector<double>> domain = {};
+  double step = (max - min) / (points_number - 1);
+
+  for(size_t i = 0; i < points_number; ++i) {
+    domain.push_back({min + i * step});
+  }
+
+  return domain;
+}
+
+void BenchmarkKDEGetValue(BenchmarkHarness *harness, const BenchmarkSettings &settings) {
+  const std::string name = "kde_get_value";
+  if(!harness->ShouldRun(name)) return;
+
+  auto domain = GenerateDomain(-5, 5, 100);
+
+  for(size_t m : {100, 500, 1000, 2000}) {
+    BenchmarkStream stream(settings.seed_);
+    auto clusters = stream.GenerateClusters(m);
+    std::unique_ptr<kernelDensityEstimator> estimator(BenchmarkStream::CreateKernelDensityEstimator(0.3));
+    estimator->_shouldConsiderWeights = false;
+    estimator->setClusters(clusters);
+
+    auto result = harness->Run(name, "m=" + std::to_string(m) + ";points=" + std::to_string(domain.size()), [&]() {
+      for(auto &pt : domain) {
+        estimator->getValue(&pt);
+      }
+    });
+
+    result->counters_.push_back({"kernel_evaluations_per_s", 1e6 * m * domain.size() / result->mean_us_});
+  }
+}
+
+void BenchmarkPluginSmoothingParameter(BenchmarkHarness *harness, const BenchmarkSettings &settings) {
+  const std::string name = "plugin_smoothing_parameter";
+  if(!harness->ShouldRun(name)) return;
+
+  for(int rank : {0, 2, 3, 4}) {
+    for(size_t m : {500, 1000}) {
+      BenchmarkStream stream(settings.seed_);
+      auto values = stream.GenerateValues(m);
+      QVector<qreal> samples(values.begin(), values.end());
+      pluginSmoothingParameterCounter counter(&samples, rank);
+
+      harness->Run(name, "rank=" + std::to_string(rank) + ";m=" + std::to_string(m), [&]() {
+        counter.countSmoothingParameterValue();
+      });
+    }
+  }
+}
+
+void BenchmarkKPSS(BenchmarkHarness *harness, const BenchmarkSettings &settings) {
+  const std::string name = "kpss_tests_value";
+  if(!harness->ShouldRun(name)) return;
+
+  for(int kpss_m : {300, 600, 1000}) {
+    BenchmarkStream stream(settings.seed_);
+    auto values = stream.GenerateValues(2 * kpss_m);
+    KPSSStationarityTest test(kpss_m);
+    size_t value_index = 0;
+
+    for(; value_index < static_cast<size_t>(kpss_m); ++value_index) {
+      test.addNewSample(values[value_index]);
+    }
+
+    // As in DESDA step, new sample is added before each test's value computation.
+    harness->Run(name, "m_kpss=" + std::to_string(kpss_m), [&]() {
+      test.addNewSample(values[value_index++ % values.size()]);
+      test.getTestsValue();
+    });
+  }
+}
+
+void BenchmarkDESDAStep(BenchmarkHarness *harness, const BenchmarkSettings &settings) {
+  const std::string name = "desda_perform_step";
+  if(!harness->ShouldRun(name)) return;
+
+  for(int max_m : {250, 500, 1000}) {
+    BenchmarkStream stream(settings.seed_);
+
+    std::shared_ptr<kernelDensityEstimator> estimator(BenchmarkStream::CreateKernelDensityEstimator());
+    std::shared_ptr<kernelDensityEstimator> derivative_estimator(BenchmarkStream::CreateKernelDensityEstimator());
+    std::shared_ptr<kernelDensityEstimator> enhanced_kde(BenchmarkStream::CreateKernelDensityEstimator());
+    estimator->_shouldConsiderWeights = false;
+    derivative_estimator->_shouldConsiderWeights = false;
+
+    int steps_number = 1000000;
+    std::unique_ptr<reservoirSamplingAlgorithm> algorithm(
+        stream.CreateReservoirSamplingAlgorithm(max_m, steps_number));
+    std::vector<std::shared_ptr<cluster>> stored_medoids = {};
+
+    DESDA desda(estimator, derivative_estimator, enhanced_kde, 0.9995, algorithm.get(), &stored_medoids,
+                &stored_medoids, 0.1, 3);
+
+    // Steps are measured once the reservoir is full and stationarity test is working.
+    int warm_up_steps_number = 2 * max_m;
+
+    for(int i = 0; i < warm_up_steps_number; ++i) {
+      desda.performStep();
+    }
+
+    harness->Run(name, "max_m=" + std::to_string(max_m), [&]() {
+      desda.performStep();
+    });
+  }
+}
+
+void BenchmarkLinearWDE(BenchmarkHarness *harness, const BenchmarkSettings &settings) {
+  const std::string update_name = "linear_wde_update";
+  const std::string value_name = "linear_wde_get_value";
+
+  for(size_t block_size : {500, 1000, 2000}) {
+    BenchmarkStream stream(settings.seed_);
+    auto block = stream.GenerateValues(block_size);
+
+    if(harness->ShouldRun(update_name)) {
+      harness->Run(update_name, "block_size=" + std::to_string(block_size), [&]() {
+        LinearWDE wde;
+        wde.UpdateWDEData(block);
+      });
+    }
+
+    if(harness->ShouldRun(value_name)) {
+      LinearWDE wde;
+      wde.UpdateWDEData(block);
+      auto domain = GenerateDomain(-5, 5, 1000);
+
+      harness->Run(value_name, "block_size=" + std::to_string(block_size) + ";points="
+                               + std::to_string(domain.size()), [&]() {
+        for(auto &pt : domain) {
+          wde.GetValue(pt[0]);
+        }
+      });
+    }
+  }
+}
+
+void BenchmarkKMeans(BenchmarkHarness *harness, const BenchmarkSettings &settings) {
+  const std::string name = "kmeans_group_objects";
+  if(!harness->ShouldRun(name)) return;
+
+  for(size_t objects_number : {500, 1000}) {
+    for(int medoids_number : {10, 50}) {
+      for(bool is_numerical : {false, true}) {
+        BenchmarkStream stream(settings.seed_);
+        auto objects = stream.GenerateObjects(objects_number);
+        auto attributes_data = stream.GetAttributesData();
+
+        // Same measures as in grouping thread.
+        attributesDistanceMeasure *CADM = new smdCategoricalAttributesDistanceMeasure();
+        attributesDistanceMeasure *NADM = new gowersNumericalAttributesDistanceMeasure(attributes_data);
+        objectsDistanceMeasure *ODM = new customObjectsDistanceMeasure(CADM, NADM, attributes_data);
+        std::shared_ptr<clustersDistanceMeasure> CDM(new centroidLinkClusterDistanceMeasure(ODM));
+
+        kMeansAlgorithm algorithm(medoids_number, CDM, kMeansAlgorithm::RANDOM_ACCORDING_TO_DISTANCE,
+                                  stream.GetParser());
+        algorithm.setNumericalGrouping(is_numerical);
+        algorithm.setSeed(settings.seed_);
+
+        harness->Run(name, "objects=" + std::to_string(objects_number) + ";k=" + std::to_string(medoids_number)
+                           + ";numerical=" + std::to_string(is_numerical), [&]() {
+          std::vector<std::shared_ptr<cluster>> target = {};
+          algorithm.groupObjects(&objects, &target);
+        });
+      }
+    }
+  }
+}
+
+void BenchmarkErrorsCalculator(BenchmarkHarness *harness, const BenchmarkSettings &settings) {
+  const std::string name = "errors_calculator";
+  if(!harness->ShouldRun(name)) return;
+
+  for(size_t points_number : {1000, 10000}) {
+    BenchmarkStream stream(settings.seed_);
+    cachedNormalMixtureDensityFunction model(stream.GetContributions(), stream.GetMeans(),
+                                             stream.GetStandardDeviations());
+
+    auto domain = GenerateDomain(-5, 5, points_number);
+    double domain_length = 10;
+    std::vector<double> model_values = model.getValues(domain);
+    std::vector<double> estimator_values = {};
+
+    for(auto &pt : domain) {
+      estimator_values.push_back(0.9 * model.getValue(&pt));
+    }
+
+    for(auto rule : {QuadratureRule::kRectangle, QuadratureRule::kSimpson}) {
+      ErrorsCalculator calculator(&model_values, &estimator_values, &domain, &domain_length, rule);
+      std::string rule_name = rule == QuadratureRule::kRectangle ? "rectangle" : "simpson";
+
+      harness->Run(name, "points=" + std::to_string(points_number) + ";rule=" + rule_name, [&]() {
+        calculator.CalculateErrors();
+      });
+    }
+  }
+}
+
+BenchmarkSettings ParseArguments(int argc, char *argv[]) {
+  BenchmarkSettings settings;
+
+  for(int i = 1; i < argc; ++i) {
+    std::string argument = argv[i];
+    size_t separator_position = argument.find('=');
+    std::string key = argument.substr(0, separator_position);
+    std::string value = separator_position == std::string::npos ? "" : argument.substr(separator_position + 1);
+
+    if(key == "--filter") settings.filter_ = value;
+    else if(key == "--format") settings.format_ = value;
+    else if(key == "--output") settings.output_path_ = value;
+    else if(key == "--min-time") settings.minimal_time_s_ = std::stod(value);
+    else if(key == "--seed") settings.seed_ = std::stoi(value);
+    else std::cerr << "Unknown argument: " << argument << "\n";
+  }
+
+  return settings;
+}
+
+int main(int argc, char *argv[]) {
+  // Estimators log a lot through qDebug, which would both pollute the output and affect the timings.
+  qInstallMessageHandler(SilentMessageHandler);
+
+  BenchmarkSettings settings = ParseArguments(argc, argv);
+  BenchmarkHarness harness(10, settings.minimal_time_s_);
+  harness.SetFilter(settings.filter_);
+
+  BenchmarkKDEGetValue(&harness, settings);
+  BenchmarkPluginSmoothingParameter(&harness, settings);
+  BenchmarkKPSS(&harness, settings);
+  BenchmarkDESDAStep(&harness, settings);
+  BenchmarkLinearWDE(&harness, settings);
+  BenchmarkKMeans(&harness, settings);
+  BenchmarkErrorsCalculator(&harness, settings);
+
+  std::ofstream file;
+  std::ostream *output = &std::cout;
+
+  if(!settings.output_path_.empty()) {
+    file.open(settings.output_path_);
+
+    if(!file.is_open()) {
+      std::cerr << "Couldn't open " << settings.output_path_ << ".\n";
+      return 1;
+    }
+
+    output = &file;
+  }
+
+  if(settings.format_ == "csv") harness.WriteCSV(*output);
+  else harness.WriteJSON(*output);
+
+  return 0;
+}
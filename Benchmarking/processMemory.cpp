@@ -0,0 +1,84 @@
+#include "processMemory.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+#ifdef __linux__
+static long long ReadProcStatusValueKB(const std::string &key) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+
+  while(std::getline(status, line)) {
+    if(line.compare(0, key.size(), key) != 0) {
+      continue;
+    }
+
+    std::istringstream values(line.substr(key.size() + 1));
+    long long value = -1;
+    values >> value;
+
+    return value;
+  }
+
+  return -1;
+}
+#endif
+
+long long ProcessMemory::GetResidentSetSizeKB() {
+#if defined(__linux__)
+  return ReadProcStatusValueKB("VmRSS");
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+
+  if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return -1;
+  }
+
+  return static_cast<long long>(counters.WorkingSetSize / 1024);
+#else
+  return -1;
+#endif
+}
+
+long long ProcessMemory::GetPeakResidentSetSizeKB() {
+#if defined(__linux__)
+  return ReadProcStatusValueKB("VmHWM");
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+
+  if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return -1;
+  }
+
+  return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+#else
+  return -1;
+#endif
+}
+
+int ProcessMemory::ResetPeakResidentSetSize() {
+  /** Resets the peak, so that it can be measured for consecutive parts of the run separately. Only Linux allows it,
+   * elsewhere the peak is the one of the whole process, so parts should be run in separate processes.
+   * @brief Resets the peak resident set size.
+   * @return 0 on success, -1 if the peak couldn't be reset.
+   */
+#ifdef __linux__
+  std::ofstream clear_refs("/proc/self/clear_refs");
+
+  if(!clear_refs.is_open()) {
+    return -1;
+  }
+
+  clear_refs << "5";
+
+  return clear_refs.good() ? 0 : -1;
+#else
+  return -1;
+#endif
+}
@@ -0,0 +1,19 @@
+#ifndef KERDEP_PROCESSMEMORY_H
+#define KERDEP_PROCESSMEMORY_H
+
+#include <cstddef>
+
+class ProcessMemory {
+
+    /** Reads memory usage of the current process. It uses /proc/self/status on Linux and process memory counters on
+     * Windows. All values are in kilobytes, -1 is returned when the value is not available on the platform.
+     *
+     * @brief Reads memory usage of the current process.
+     */
+  public:
+    static long long GetResidentSetSizeKB();
+    static long long GetPeakResidentSetSizeKB();
+    static int ResetPeakResidentSetSize();
+};
+
+#endif //KERDEP_PROCESSMEMORY_H
@@ -0,0 +1,218 @@
+#include "stepProfiler.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+StepProfiler &StepProfiler::Instance() {
+  /** Returns the profiler shared by all of the profiled code. It's constructed in static storage, without operator
+   * new (which counts the allocations with the profiler), and never destroyed, so that allocations made during the
+   * static destruction don't touch a destroyed profiler.
+   * @brief Returns the profiler shared by all of the profiled code.
+   */
+  alignas(StepProfiler) static unsigned char storage[sizeof(StepProfiler)];
+  static StepProfiler *profiler = new(storage) StepProfiler();
+  return *profiler;
+}
+
+void StepProfiler::BeginStep(const int &step_number) {
+  /** Opens the record of a new step. Records are gathered on the calling thread only.
+   * @brief Opens the record of a new step.
+   * @param step_number - Number of the step.
+   */
+  current_record_ = StepProfileRecord();
+  current_record_.step_number_ = step_number;
+  step_thread_id_ = std::this_thread::get_id();
+  is_step_open_ = true;
+}
+
+void StepProfiler::EndStep() {
+  /** Closes the record of current step and stores it.
+   * @brief Closes the record of current step and stores it.
+   */
+  if(!IsRecording()) {
+    return;
+  }
+
+  // Step is closed first, so that storing the record doesn't count as its allocation.
+  is_step_open_ = false;
+  records_.push_back(current_record_);
+}
+
+void StepProfiler::AddPhaseDuration(const ProfiledPhase &phase, const double &duration_us) {
+  /** Adds duration to the phase of current step. Phase may be measured multiple times in one step.
+   * @brief Adds duration to the phase of current step.
+   */
+  if(!IsRecording()) {
+    return;
+  }
+
+  current_record_.phases_durations_us_[static_cast<size_t>(phase)] += duration_us;
+}
+
+void StepProfiler::IncrementCounter(const ProfiledCounter &counter, const unsigned long long &value) {
+  /** Increments the counter of current step.
+   * @brief Increments the counter of current step.
+   */
+  if(!IsRecording()) {
+    return;
+  }
+
+  current_record_.counters_[static_cast<size_t>(counter)] += value;
+}
+
+const std::vector<StepProfileRecord> &StepProfiler::GetRecords() const {
+  return records_;
+}
+
+void StepProfiler::Clear() {
+  records_.clear();
+  is_step_open_ = false;
+}
+
+int StepProfiler::ExportToCSV(const std::string &path) const {
+  /** Writes gathered records as CSV, one step per row. Durations are in microseconds.
+   * @brief Writes gathered records as CSV, one step per row.
+   * @param path - Path of the target file.
+   * @return 0 on success, -1 if the file couldn't be opened.
+   */
+  std::ofstream file(path);
+
+  if(!file.is_open()) {
+    return -1;
+  }
+
+  file << "step";
+
+  for(int i = 0; i < static_cast<int>(ProfiledPhase::kPhasesNumber); ++i) {
+    file << "," << GetPhaseName(static_cast<ProfiledPhase>(i)) << "_us";
+  }
+
+  for(int i = 0; i < static_cast<int>(ProfiledCounter::kCountersNumber); ++i) {
+    file << "," << GetCounterName(static_cast<ProfiledCounter>(i));
+  }
+
+  file << "\n";
+
+  for(const auto &record : records_) {
+    file << record.step_number_;
+
+    for(auto duration : record.phases_durations_us_) {
+      file << "," << duration;
+    }
+
+    for(auto counter : record.counters_) {
+      file << "," << counter;
+    }
+
+    file << "\n";
+  }
+
+  return 0;
+}
+
+int StepProfiler::ExportToJSON(const std::string &path) const {
+  /** Writes gathered records as JSON array of step objects. Durations are in microseconds.
+   * @brief Writes gathered records as JSON array of step objects.
+   * @param path - Path of the target file.
+   * @return 0 on success, -1 if the file couldn't be opened.
+   */
+  std::ofstream file(path);
+
+  if(!file.is_open()) {
+    return -1;
+  }
+
+  file << "[\n";
+
+  for(size_t r = 0; r < records_.size(); ++r) {
+    const auto &record = records_[r];
+    file << "  {\"step\": " << record.step_number_ << ", \"phases_us\": {";
+
+    for(int i = 0; i < static_cast<int>(ProfiledPhase::kPhasesNumber); ++i) {
+      file << (i == 0 ? "" : ", ") << "\"" << GetPhaseName(static_cast<ProfiledPhase>(i)) << "\": "
+           << record.phases_durations_us_[i];
+    }
+
+    file << "}, \"counters\": {";
+
+    for(int i = 0; i < static_cast<int>(ProfiledCounter::kCountersNumber); ++i) {
+      file << (i == 0 ? "" : ", ") << "\"" << GetCounterName(static_cast<ProfiledCounter>(i)) << "\": "
+           << record.counters_[i];
+    }
+
+    file << "}}" << (r + 1 == records_.size() ? "\n" : ",\n");
+  }
+
+  file << "]\n";
+
+  return 0;
+}
+
+std::string StepProfiler::GetPhaseName(const ProfiledPhase &phase) {
+  switch(phase) {
+    case ProfiledPhase::kStep: return "step";
+    case ProfiledPhase::kReservoirMovement: return "reservoir_movement";
+    case ProfiledPhase::kStationarityTest: return "stationarity_test";
+    case ProfiledPhase::kWindowedSmoothingParameter: return "windowed_smoothing_parameter";
+    case ProfiledPhase::kSmoothingParameter: return "smoothing_parameter";
+    case ProfiledPhase::kWeightsUpdate: return "weights_update";
+    case ProfiledPhase::kKDEOnClusters: return "kde_on_clusters";
+    case ProfiledPhase::kPrognosisUpdate: return "prognosis_update";
+    case ProfiledPhase::kDerivativeOnClusters: return "derivative_on_clusters";
+    case ProfiledPhase::kMaxAbsUpdates: return "max_abs_updates";
+    default: return "unknown";
+  }
+}
+
+std::string StepProfiler::GetCounterName(const ProfiledCounter &counter) {
+  switch(counter) {
+    case ProfiledCounter::kKernelEvaluations: return "kernel_evaluations";
+    case ProfiledCounter::kAllocations: return "allocations";
+    case ProfiledCounter::kAllocatedBytes: return "allocated_bytes";
+    case ProfiledCounter::kBandwidthRecomputations: return "bandwidth_recomputations";
+    case ProfiledCounter::kBandwidthApproximations: return "bandwidth_approximations";
+    default: return "unknown";
+  }
+}
+
+bool StepProfiler::IsRecording() const {
+  return is_step_open_ && std::this_thread::get_id() == step_thread_id_;
+}
+
+ScopedPhaseTimer::ScopedPhaseTimer(const ProfiledPhase &phase)
+  : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+ScopedPhaseTimer::~ScopedPhaseTimer() {
+  auto duration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_);
+  StepProfiler::Instance().AddPhaseDuration(phase_, duration.count());
+}
+
+#ifdef KERDEP_PROFILING
+// Replaced global allocation functions, counting the allocations of the profiled steps. Array and sized forms of
+// the standard library call these.
+void *operator new(std::size_t size) {
+  KERDEP_PROFILE_COUNT(ProfiledCounter::kAllocations, 1);
+  KERDEP_PROFILE_COUNT(ProfiledCounter::kAllocatedBytes, size);
+
+  if(void *pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  KERDEP_PROFILE_COUNT(ProfiledCounter::kAllocations, 1);
+  KERDEP_PROFILE_COUNT(ProfiledCounter::kAllocatedBytes, size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+  std::free(pointer);
+}
+#endif
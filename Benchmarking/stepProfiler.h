@@ -0,0 +1,111 @@
+#ifndef KERDEP_STEPPROFILER_H
+#define KERDEP_STEPPROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+/** Phases of the DESDA step that are timed separately. Keep kPhasesNumber last.
+ */
+enum class ProfiledPhase : int {
+  kStep = 0,
+  kReservoirMovement,
+  kStationarityTest,
+  kWindowedSmoothingParameter,
+  kSmoothingParameter,
+  kWeightsUpdate,
+  kKDEOnClusters,
+  kPrognosisUpdate,
+  kDerivativeOnClusters,
+  kMaxAbsUpdates,
+  kPhasesNumber
+};
+
+/** Events counted during the step. Keep kCountersNumber last. Allocations are counted by the replaced global
+ * operator new, so they include all the heap allocations made on the thread of the step.
+ */
+enum class ProfiledCounter : int {
+  kKernelEvaluations = 0,
+  kAllocations,
+  kAllocatedBytes,
+  kBandwidthRecomputations,
+  kBandwidthApproximations,
+  kCountersNumber
+};
+
+struct StepProfileRecord {
+  int step_number_ = 0;
+  std::array<double, static_cast<size_t>(ProfiledPhase::kPhasesNumber)> phases_durations_us_ = {};
+  std::array<unsigned long long, static_cast<size_t>(ProfiledCounter::kCountersNumber)> counters_ = {};
+};
+
+class StepProfiler {
+
+    /** Gathers per-phase durations and event counters of consecutive algorithm steps. Values are accumulated into
+     * the record of the currently open step and only on the thread that opened it, so that e.g. drawing from other
+     * threads doesn't affect the counters. Use KERDEP_PROFILE_* macros instead of calling it directly, so that
+     * profiling compiles to nothing unless KERDEP_PROFILING is defined.
+     *
+     * @brief Gathers per-phase durations and event counters of consecutive algorithm steps.
+     */
+  public:
+    static StepProfiler &Instance();
+
+    void BeginStep(const int &step_number);
+    void EndStep();
+    void AddPhaseDuration(const ProfiledPhase &phase, const double &duration_us);
+    void IncrementCounter(const ProfiledCounter &counter, const unsigned long long &value = 1);
+
+    const std::vector<StepProfileRecord> &GetRecords() const;
+    void Clear();
+
+    int ExportToCSV(const std::string &path) const;
+    int ExportToJSON(const std::string &path) const;
+
+    static std::string GetPhaseName(const ProfiledPhase &phase);
+    static std::string GetCounterName(const ProfiledCounter &counter);
+
+  protected:
+    StepProfiler() = default;
+
+    std::vector<StepProfileRecord> records_ = {};
+    StepProfileRecord current_record_;
+    std::atomic<bool> is_step_open_{false};
+    std::atomic<std::thread::id> step_thread_id_{};
+
+    bool IsRecording() const;
+};
+
+class ScopedPhaseTimer {
+
+    /** Measures time from construction to destruction and adds it to given phase of the current step.
+     * @brief Measures time from construction to destruction and adds it to given phase of the current step.
+     */
+  public:
+    explicit ScopedPhaseTimer(const ProfiledPhase &phase);
+    ~ScopedPhaseTimer();
+
+  protected:
+    ProfiledPhase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#ifdef KERDEP_PROFILING
+#define KERDEP_PROFILE_CONCATENATE_(a, b) a##b
+#define KERDEP_PROFILE_CONCATENATE(a, b) KERDEP_PROFILE_CONCATENATE_(a, b)
+#define KERDEP_PROFILE_STEP_BEGIN(step_number) StepProfiler::Instance().BeginStep(step_number)
+#define KERDEP_PROFILE_STEP_END() StepProfiler::Instance().EndStep()
+#define KERDEP_PROFILE_SCOPE(phase) \
+  ScopedPhaseTimer KERDEP_PROFILE_CONCATENATE(kerdep_phase_timer_, __LINE__)(phase)
+#define KERDEP_PROFILE_COUNT(counter, value) StepProfiler::Instance().IncrementCounter(counter, value)
+#else
+#define KERDEP_PROFILE_STEP_BEGIN(step_number) ((void) 0)
+#define KERDEP_PROFILE_STEP_END() ((void) 0)
+#define KERDEP_PROFILE_SCOPE(phase) ((void) 0)
+#define KERDEP_PROFILE_COUNT(counter, value) ((void) 0)
+#endif
+
+#endif //KERDEP_STEPPROFILER_H
@@ -0,0 +1,448 @@
+// End-to-end throughput benchmark of the streaming estimators. One stream, including the progression of the means
+// of the progressive distribution data reader, is generated beforehand and replayed to every estimator, so that
+// they all process exactly the same elements. For each estimator it reports processed elements per second, per step
+// latency percentiles, memory usage and mean L2 error against the model.
+//
+// Usage: KerDEPThroughputBenchmark [--estimator=all|desda|cluster_kernels|cc_wde|windowed_wde|somke]
+//                                  [--steps=<number>] [--error-frequency=<steps>] [--format=json|csv]
+//                                  [--output=<path>] [--seed=<seed>] [--desda-batch=<elements>]
+//                                  [--desda-bandwidth-schedule=<tolerance>] [--desda-incremental-kde=<tolerance>]
+//                                  [--desda-kernel-cache] [--desda-background-grouping=<steps>]
+// With --desda-batch DESDA ingests every element, but refreshes its estimator once per batch (see
+// DESDA::performSteps), so its errors are computed on an estimator that may be a few elements old.
+// With --desda-bandwidth-schedule DESDA reruns the plug-in smoothing parameters only when needed (see
+// DESDA::setSmoothingParameterScheduling) and reports how many plug-in runs and approximations it made.
+// With --desda-incremental-kde DESDA updates KDE values on clusters incrementally (see
+// DESDA::setIncrementalKDEOnClusters), as long as h changes by at most given tolerance.
+// With --desda-kernel-cache DESDA reuses kernel values between pairs of clusters (see DESDA::setKernelMatrixCaching).
+// With --desda-background-grouping DESDA groups its clusters into medoids every given number of steps on a separate
+// thread, which stores them in the clusters, as in the experiments (see DESDA::setBackgroundGrouping).
+// Peak memory can only be reset between estimators on Linux. Elsewhere run each estimator in separate process.
+
+#include <QString>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmarkHarness.h"
+#include "benchmarkStream.h"
+#include "errorsCalculator.h"
+#include "processMemory.h"
+
+#include "../DESDA.h"
+#include "../Functions/cachednormalmixturedensityfunction.h"
+#include "../Reservoir_sampling/basicReservoirSamplingAlgorithm.h"
+#include "../Reservoir_sampling/distributiondataparser.h"
+#include "../Reservoir_sampling/vectorDataReader.h"
+#include "../groupingThread/groupingThread.h"
+
+#include "../ClusterKernelWrappers/enhancedClusterKernelAlgorithm.h"
+#include "../ClusterKernelWrappers/varianceBasedClusterKernel.h"
+#include "../ClusterKernelWrappers/univariateStreamElement.h"
+
+#include "kerDepCcWde.h"
+#include "kerDepWindowedWde.h"
+#include "LinearWDE.h"
+#include "WeightedThresholdedWDE.h"
+#include "ThresholdingStrategies/softThresholdingStrategy.h"
+
+#include "SOMKEAlgorithm.h"
+#include "../SOMKEWrappers/somkeNormalKernel.h"
+#include "../SOMKEWrappers/MergingStrategies/somkeFixedThresholdMergingStrategy.h"
+
+struct ThroughputSettings {
+  std::string estimator_ = "all";
+  std::string format_ = "json";
+  std::string output_path_ = "";
+  int steps_number_ = 15000;
+  int error_frequency_ = 10;
+  int first_error_step_ = 1000; // As in the experiments, errors are computed once the estimators have settled.
+  int seed_ = 5625;
+  int desda_batch_size_ = 1;
+  double desda_bandwidth_tolerance_ = 0; // Bandwidth scheduling is disabled if not positive.
+  double desda_incremental_kde_tolerance_ = -1; // Incremental KDE on clusters is disabled if negative.
+  bool is_desda_kernel_cache_enabled_ = false;
+  int desda_steps_between_groupings_ = 0; // Background grouping is disabled if not positive.
+};
+
+// Estimator under test. Step performs one step of the estimator and is the only timed part. Values computes
+// estimator values on its own error domain, which are then compared with the model.
+struct StreamingEstimator {
+  std::string name_ = "";
+  std::string parameters_ = "";
+  std::function<void(const std::vector<double> &)> step_;
+  std::function<void(std::vector<std::vector<double>> *, std::vector<double> *)> values_;
+};
+
+static void SilentMessageHandler(QtMsgType, const QMessageLogContext &, const QString &) {}
+
+static ClusterKernel *CreateVarianceBasedClusterKernel(ClusterKernelStreamElement *stream_element) {
+  return new VarianceBasedClusterKernel(stream_element);
+}
+
+static WaveletDensityEstimator *CreateLinearWDEFromBlock(const vector<double> &values_block) {
+  auto wde = new LinearWDE();
+  wde->UpdateWDEData(values_block);
+  return wde;
+}
+
+static WaveletDensityEstimator *CreateWeightedThresholdedWDEFromBlock(const vector<double> &values_block) {
+  auto thresholding_strategy = ThresholdingStrategyPtr(new SoftThresholdingStrategy);
+  auto wde = new WeightedThresholdedWDE(thresholding_strategy);
+  wde->UpdateWDEData(values_block);
+  return wde;
+}
+
+static void ApplyMeans(const std::vector<double> &flattened_means,
+                       std::vector<std::shared_ptr<std::vector<double>>> *means) {
+  size_t i = 0;
+
+  for(auto &component_means : *means) {
+    for(auto &mean : *component_means) {
+      mean = flattened_means[i++];
+    }
+  }
+}
+
+static BenchmarkResult RunEstimator(const StreamingEstimator &estimator, const ThroughputSettings &settings,
+                                    const std::vector<std::vector<double>> &stream_data,
+                                    const std::vector<std::vector<double>> &means_history,
+                                    BenchmarkStream *stream) {
+  std::vector<std::shared_ptr<std::vector<double>>> means = {};
+
+  for(const auto &component_means : *stream->GetMeans()) {
+    means.push_back(std::make_shared<std::vector<double>>(*component_means));
+  }
+
+  cachedNormalMixtureDensityFunction model(stream->GetContributions(), &means, stream->GetStandardDeviations());
+
+  std::vector<std::vector<double>> error_domain = {};
+  std::vector<double> model_values = {};
+  std::vector<double> estimator_values = {};
+  double error_domain_length = 0;
+  ErrorsCalculator errors_calculator(&model_values, &estimator_values, &error_domain, &error_domain_length);
+
+  std::vector<double> durations_us = {};
+  double l2_sum = 0;
+  int error_calculations_number = 0;
+
+  long long initial_rss_kb = ProcessMemory::GetResidentSetSizeKB();
+  bool is_peak_reset = ProcessMemory::ResetPeakResidentSetSize() == 0;
+
+  for(int step_number = 1; step_number <= settings.steps_number_; ++step_number) {
+    const auto &element = stream_data[step_number - 1];
+
+    auto start = std::chrono::steady_clock::now();
+    estimator.step_(element);
+    durations_us.push_back(
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+    if(step_number < settings.first_error_step_ || step_number % settings.error_frequency_ != 0) {
+      continue;
+    }
+
+    ApplyMeans(means_history[step_number - 1], &means);
+    model.setMeans(means);
+
+    estimator.values_(&error_domain, &estimator_values);
+
+    if(error_domain.size() < 2) {
+      continue;
+    }
+
+    model_values = model.getValues(error_domain);
+    error_domain_length = error_domain.back()[0] - error_domain.front()[0];
+
+    l2_sum += errors_calculator.CalculateErrors().l2_;
+    ++error_calculations_number;
+  }
+
+  double total_time_us = 0;
+
+  for(auto duration : durations_us) {
+    total_time_us += duration;
+  }
+
+  auto sorted_durations_us = durations_us;
+  std::sort(sorted_durations_us.begin(), sorted_durations_us.end());
+
+  auto result = BenchmarkHarness::SummarizeDurations(estimator.name_, estimator.parameters_, durations_us);
+  result.counters_.push_back({"elements_per_s", total_time_us > 0 ? 1e6 * durations_us.size() / total_time_us : 0});
+  result.counters_.push_back({"p50_us", BenchmarkHarness::GetPercentile(sorted_durations_us, 50)});
+  result.counters_.push_back({"p90_us", BenchmarkHarness::GetPercentile(sorted_durations_us, 90)});
+  result.counters_.push_back({"p99_us", BenchmarkHarness::GetPercentile(sorted_durations_us, 99)});
+  result.counters_.push_back({"rss_growth_kb", static_cast<double>(ProcessMemory::GetResidentSetSizeKB()
+                                                                   - initial_rss_kb)});
+  result.counters_.push_back({"peak_rss_kb", static_cast<double>(ProcessMemory::GetPeakResidentSetSizeKB())});
+  result.counters_.push_back({"is_peak_per_estimator", is_peak_reset ? 1 : 0});
+  result.counters_.push_back({"mean_l2", error_calculations_number > 0 ? l2_sum / error_calculations_number : -1});
+  result.counters_.push_back({"error_calculations", static_cast<double>(error_calculations_number)});
+
+  return result;
+}
+
+static BenchmarkResult RunDESDA(const ThroughputSettings &settings, const std::vector<std::vector<double>> &stream_data,
+                                const std::vector<std::vector<double>> &means_history, BenchmarkStream *stream) {
+  // Same set-up as in the DESDA experiment, but the data is replayed.
+  int sample_size = 1000;
+
+  std::unordered_map<std::string, attributeData *> attributes_data = {};
+  VectorDataReader reader(&stream_data);
+  distributionDataParser parser(&attributes_data);
+  reader.gatherAttributesData(&attributes_data);
+  parser.setAttributesOrder(reader.getAttributesOrder());
+  basicReservoirSamplingAlgorithm algorithm(&reader, &parser, sample_size, settings.steps_number_);
+
+  std::shared_ptr<kernelDensityEstimator> estimator(BenchmarkStream::CreateKernelDensityEstimator());
+  std::shared_ptr<kernelDensityEstimator> derivative_estimator(BenchmarkStream::CreateKernelDensityEstimator());
+  std::shared_ptr<kernelDensityEstimator> enhanced_kde(BenchmarkStream::CreateKernelDensityEstimator());
+  estimator->_shouldConsiderWeights = false;
+  derivative_estimator->_shouldConsiderWeights = false;
+
+  std::vector<std::shared_ptr<cluster>> stored_medoids = {};
+  DESDA desda(estimator, derivative_estimator, enhanced_kde, 0.9995, &algorithm, &stored_medoids, &stored_medoids,
+              0.1, 3);
+
+  StreamingEstimator streaming_estimator;
+  streaming_estimator.name_ = "desda";
+  streaming_estimator.parameters_ = "m0=" + std::to_string(sample_size) + ";plugin_rank=3;batch="
+                                    + std::to_string(settings.desda_batch_size_);
+
+  if(settings.desda_bandwidth_tolerance_ > 0) {
+    desda.setSmoothingParameterScheduling(true, settings.desda_bandwidth_tolerance_);
+    streaming_estimator.parameters_ += ";bandwidth_tolerance=" + std::to_string(settings.desda_bandwidth_tolerance_);
+  }
+
+  if(settings.desda_incremental_kde_tolerance_ >= 0) {
+    desda.setIncrementalKDEOnClusters(true, settings.desda_incremental_kde_tolerance_);
+    streaming_estimator.parameters_ +=
+        ";incremental_kde_tolerance=" + std::to_string(settings.desda_incremental_kde_tolerance_);
+  }
+
+  if(settings.is_desda_kernel_cache_enabled_) {
+    desda.setKernelMatrixCaching(true);
+    streaming_estimator.parameters_ += ";kernel_cache=1";
+  }
+
+  // Grouping has its own parser, as it creates the medoids on its thread.
+  auto grouping_parser = std::make_shared<distributionDataParser>(&attributes_data);
+  grouping_parser->setAttributesOrder(reader.getAttributesOrder());
+  groupingThread grouping(&stored_medoids, grouping_parser);
+
+  if(settings.desda_steps_between_groupings_ > 0) {
+    int medoids_number = 50;
+    grouping.setAttributesData(&attributes_data);
+    grouping.initialize(medoids_number, 2 * medoids_number);
+    desda.setBackgroundGrouping(&grouping, settings.desda_steps_between_groupings_);
+    streaming_estimator.parameters_ +=
+        ";steps_between_groupings=" + std::to_string(settings.desda_steps_between_groupings_);
+  }
+
+  int pending_elements_number = 0;
+  // DESDA reads the element from its reservoir sampling algorithm. In batched mode the refresh of the estimator is
+  // timed with the last element of the batch.
+  streaming_estimator.step_ = [&](const std::vector<double> &) {
+    if(settings.desda_batch_size_ <= 1) {
+      desda.performStep();
+      return;
+    }
+
+    desda.ingestElement();
+
+    if(++pending_elements_number < settings.desda_batch_size_) return;
+
+    desda.refreshEstimator();
+    pending_elements_number = 0;
+  };
+  streaming_estimator.values_ = [&](std::vector<std::vector<double>> *domain, std::vector<double> *values) {
+    domain->clear();
+
+    for(auto x : desda.getErrorDomain(0)) {
+      domain->push_back({x});
+    }
+
+    *values = desda.getRareElementsEnhancedKDEValues(domain);
+  };
+
+  BenchmarkResult result = RunEstimator(streaming_estimator, settings, stream_data, means_history, stream);
+
+  if(settings.desda_steps_between_groupings_ > 0) {
+    result.counters_.push_back({"medoids_epoch", static_cast<double>(desda.getStoredMedoidsEpoch())});
+  }
+
+  if(settings.desda_bandwidth_tolerance_ > 0) {
+    result.counters_.push_back({"bandwidth_plugin_runs",
+                                static_cast<double>(desda.getSmoothingParameterPluginRunsNumber())});
+    result.counters_.push_back({"bandwidth_approximations",
+                                static_cast<double>(desda.getSmoothingParameterApproximationsNumber())});
+  }
+
+  return result;
+}
+
+static BenchmarkResult RunClusterKernels(const ThroughputSettings &settings,
+                                         const std::vector<std::vector<double>> &stream_data,
+                                         const std::vector<std::vector<double>> &means_history,
+                                         BenchmarkStream *stream) {
+  int number_of_cluster_kernels = 100;
+  EnhancedClusterKernelAlgorithm algorithm(number_of_cluster_kernels, CreateVarianceBasedClusterKernel);
+
+  StreamingEstimator streaming_estimator;
+  streaming_estimator.name_ = "cluster_kernels";
+  streaming_estimator.parameters_ = "m=" + std::to_string(number_of_cluster_kernels);
+  streaming_estimator.step_ = [&](const std::vector<double> &element) {
+    UnivariateStreamElement stream_element(element);
+    algorithm.PerformStep(&stream_element);
+  };
+  streaming_estimator.values_ = [&](std::vector<std::vector<double>> *domain, std::vector<double> *values) {
+    *domain = algorithm.GetErrorDomain();
+    *values = algorithm.GetKDEValuesOnDomain(*domain);
+  };
+
+  return RunEstimator(streaming_estimator, settings, stream_data, means_history, stream);
+}
+
+static BenchmarkResult RunWDE(const ThroughputSettings &settings, const std::vector<std::vector<double>> &stream_data,
+                              const std::vector<std::vector<double>> &means_history, BenchmarkStream *stream,
+                              const bool &is_windowed) {
+  unsigned int maximal_number_of_coefficients = 100;
+  double weight_modifier = 0.95;
+  unsigned int block_size = 1000;
+
+  std::unique_ptr<KerDEP_CC_WDE> algorithm;
+
+  if(is_windowed) {
+    algorithm.reset(new KerDEPWindowedWDE(maximal_number_of_coefficients, weight_modifier,
+                                          CreateWeightedThresholdedWDEFromBlock, block_size));
+  } else {
+    algorithm.reset(new KerDEP_CC_WDE(maximal_number_of_coefficients, weight_modifier, CreateLinearWDEFromBlock,
+                                      block_size));
+  }
+
+  StreamingEstimator streaming_estimator;
+  streaming_estimator.name_ = is_windowed ? "windowed_wde" : "cc_wde";
+  streaming_estimator.parameters_ = "M=" + std::to_string(maximal_number_of_coefficients) + ";b="
+                                    + std::to_string(block_size) + ";omega=" + std::to_string(weight_modifier);
+  streaming_estimator.step_ = [&](const std::vector<double> &element) {
+    point pt = element;
+    algorithm->PerformStep(&pt);
+  };
+  streaming_estimator.values_ = [&](std::vector<std::vector<double>> *domain, std::vector<double> *values) {
+    *domain = algorithm->GetErrorDomain();
+    *values = algorithm->GetEstimatorValuesOnDomain(*domain);
+  };
+
+  return RunEstimator(streaming_estimator, settings, stream_data, means_history, stream);
+}
+
+static BenchmarkResult RunSOMKE(const ThroughputSettings &settings, const std::vector<std::vector<double>> &stream_data,
+                                const std::vector<std::vector<double>> &means_history, BenchmarkStream *stream) {
+  int neurons_number = 100;
+  int epochs_number = 3000;
+  int data_window_size = 500;
+  double alpha = 1.0;
+  double beta = 0;
+
+  KernelPtr kernel(new SOMKENormalKernel());
+  MergingStrategyPtr merging_strategy(new SOMKEFixedThresholdMergingStrategy(alpha, beta));
+  SOMKEAlgorithm algorithm(kernel, merging_strategy, neurons_number, epochs_number, data_window_size);
+
+  StreamingEstimator streaming_estimator;
+  streaming_estimator.name_ = "somke";
+  streaming_estimator.parameters_ = "neurons=" + std::to_string(neurons_number) + ";epochs="
+                                    + std::to_string(epochs_number) + ";window="
+                                    + std::to_string(data_window_size);
+  streaming_estimator.step_ = [&](const std::vector<double> &element) {
+    algorithm.PerformStep(element);
+  };
+  streaming_estimator.values_ = [&](std::vector<std::vector<double>> *domain, std::vector<double> *values) {
+    *domain = algorithm.divergence_domain_;
+    values->clear();
+
+    for(auto pt : *domain) {
+      values->push_back(algorithm.GetValue(pt));
+    }
+  };
+
+  return RunEstimator(streaming_estimator, settings, stream_data, means_history, stream);
+}
+
+static ThroughputSettings ParseArguments(int argc, char *argv[]) {
+  ThroughputSettings settings;
+
+  for(int i = 1; i < argc; ++i) {
+    std::string argument = argv[i];
+    size_t separator_position = argument.find('=');
+    std::string key = argument.substr(0, separator_position);
+    std::string value = separator_position == std::string::npos ? "" : argument.substr(separator_position + 1);
+
+    if(key == "--estimator") settings.estimator_ = value;
+    else if(key == "--format") settings.format_ = value;
+    else if(key == "--output") settings.output_path_ = value;
+    else if(key == "--steps") settings.steps_number_ = std::stoi(value);
+    else if(key == "--error-frequency") settings.error_frequency_ = std::max(1, std::stoi(value));
+    else if(key == "--seed") settings.seed_ = std::stoi(value);
+    else if(key == "--desda-batch") settings.desda_batch_size_ = std::max(1, std::stoi(value));
+    else if(key == "--desda-bandwidth-schedule") settings.desda_bandwidth_tolerance_ = std::stod(value);
+    else if(key == "--desda-incremental-kde") settings.desda_incremental_kde_tolerance_ = std::stod(value);
+    else if(key == "--desda-kernel-cache") settings.is_desda_kernel_cache_enabled_ = true;
+    else if(key == "--desda-background-grouping") settings.desda_steps_between_groupings_ = std::stoi(value);
+    else std::cerr << "Unknown argument: " << argument << "\n";
+  }
+
+  return settings;
+}
+
+int main(int argc, char *argv[]) {
+  // Estimators log a lot through qDebug, which would both pollute the output and affect the timings.
+  qInstallMessageHandler(SilentMessageHandler);
+
+  ThroughputSettings settings = ParseArguments(argc, argv);
+
+  BenchmarkStream stream(settings.seed_);
+  std::vector<std::vector<double>> means_history = {};
+  // DESDA's reservoir may read one more element than there are steps, hence the margin.
+  auto stream_data = stream.GenerateRawData(settings.steps_number_ + 1, &means_history);
+
+  BenchmarkHarness harness;
+  auto should_run = [&](const std::string &name) {
+    return settings.estimator_ == "all" || settings.estimator_ == name;
+  };
+
+  if(should_run("desda"))
+    harness.AddResult(RunDESDA(settings, stream_data, means_history, &stream));
+  if(should_run("cluster_kernels"))
+    harness.AddResult(RunClusterKernels(settings, stream_data, means_history, &stream));
+  if(should_run("cc_wde"))
+    harness.AddResult(RunWDE(settings, stream_data, means_history, &stream, false));
+  if(should_run("windowed_wde"))
+    harness.AddResult(RunWDE(settings, stream_data, means_history, &stream, true));
+  if(should_run("somke"))
+    harness.AddResult(RunSOMKE(settings, stream_data, means_history, &stream));
+
+  std::ofstream file;
+  std::ostream *output = &std::cout;
+
+  if(!settings.output_path_.empty()) {
+    file.open(settings.output_path_);
+
+    if(!file.is_open()) {
+      std::cerr << "Couldn't open " << settings.output_path_ << ".\n";
+      return 1;
+    }
+
+    output = &file;
+  }
+
+  if(settings.format_ == "csv") harness.WriteCSV(*output);
+  else harness.WriteJSON(*output);
+
+  return 0;
+}
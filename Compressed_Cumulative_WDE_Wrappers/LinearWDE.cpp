@@ -93,17 +93,12 @@ void LinearWDE::ComputeEmpiricalScalingCoefficients(const vector<StreamElementDa
     return;
   }
 
-  for(int k = k_min_; k <= k_max_; ++k){
-
-    double coefficient = 0;
+  auto sums = ComputeWeightedFunctionSums(values, *scaling_function_table_, scaling_function_resolution_index_,
+                                          k_min_, k_max_);
 
-    translated_dilated_scaling_function_.UpdateIndices(scaling_function_resolution_index_, k);
-
-    for(auto val : values){
-      coefficient += translated_dilated_scaling_function_.GetValue(val.value_);
-    }
+  for(int k = k_min_; k <= k_max_; ++k){
 
-    coefficient /= values.size();
+    double coefficient = sums[k - k_min_] / values.size();
 
     EmpiricalCoefficientData data;
     data.coefficient_ = coefficient;
@@ -114,6 +109,37 @@ void LinearWDE::ComputeEmpiricalScalingCoefficients(const vector<StreamElementDa
 
 }
 
+/** Computes sums of weighted values of translated dilated function, for translations from k_min to k_max.
+ *
+ * Each value only contributes to the translations whose support contains it, so the cost is proportional to the
+ * number of values times the length of the support, not to the number of translations.
+ *
+ * @brief Computes sums of weighted values of translated dilated function, for translations from k_min to k_max.
+ * @param values - Values (with weights) in the block.
+ * @param function - Tabulated function.
+ * @param j - Dilation (resolution) index.
+ * @param k_min - First translation.
+ * @param k_max - Last translation.
+ * @return Sums, k_min first.
+ */
+vector<double> LinearWDE::ComputeWeightedFunctionSums(const vector<StreamElementData> &values,
+                                                      const TabulatedWaveletFunction &function, const int &j,
+                                                      const int &k_min, const int &k_max) const {
+  vector<double> sums(std::max(k_max - k_min + 1, 0), 0.0);
+
+  for(const auto &val : values){
+    auto translations = function.GetTranslationsRange(val.value_, j);
+    int k_begin = std::max(translations.first, k_min);
+    int k_end = std::min(translations.second, k_max);
+
+    for(int k = k_begin; k <= k_end; ++k){
+      sums[k - k_min] += function.GetValue(val.value_, j, k) * val.weight_;
+    }
+  }
+
+  return sums;
+}
+
 /** Computes value of decomposed function in 1D point.
  * @brief Computes value of decomposed function in 1D point.
  * @param x - 1D point in which the value of function should be computed.
@@ -122,14 +148,53 @@ void LinearWDE::ComputeEmpiricalScalingCoefficients(const vector<StreamElementDa
 double LinearWDE::GetValue(const double &x) const {
   double result = 0;
 
-  for(auto data : empirical_scaling_coefficients_){
-    translated_dilated_scaling_function_.UpdateIndices(data.j_, data.k_);
-    result += data.coefficient_ * translated_dilated_scaling_function_.GetValue(x);
+  for(const auto &data : empirical_scaling_coefficients_){
+    result += data.coefficient_ * scaling_function_table_->GetValue(x, data.j_, data.k_);
   }
 
   return weight_ * result;
 }
 
+/** Adds values of the estimator in the points of sorted grid to the values.
+ *
+ * Each coefficient is only evaluated in the points within its function's support, which are found by binary search,
+ * so the cost is proportional to the number of coefficients times the number of points per support, not to the
+ * number of coefficients times the number of points. Values of many estimators can be accumulated in one vector.
+ *
+ * @brief Adds values of the estimator in the points of sorted grid to the values.
+ * @param sorted_x - Points, in ascending order.
+ * @param values - Values in the points, to which values of the estimator are added.
+ */
+void LinearWDE::AccumulateValues(const vector<double> &sorted_x, vector<double> *values) const {
+  for(const auto &data : empirical_scaling_coefficients_){
+    AccumulateFunctionValues(sorted_x, *scaling_function_table_, data.j_, data.k_, weight_ * data.coefficient_,
+                             values);
+  }
+}
+
+/** Adds values of multiplied translated dilated function in the points of sorted grid within its support.
+ * @brief Adds values of multiplied translated dilated function in the points of sorted grid within its support.
+ * @param sorted_x - Points, in ascending order.
+ * @param function - Tabulated function.
+ * @param j - Dilation (resolution) index.
+ * @param k - Translation index.
+ * @param multiplier - Multiplier of the function's values, e.g. weighted coefficient.
+ * @param values - Values in the points, to which the function's values are added.
+ */
+void LinearWDE::AccumulateFunctionValues(const vector<double> &sorted_x, const TabulatedWaveletFunction &function,
+                                         const int &j, const int &k, const double &multiplier,
+                                         vector<double> *values) const {
+  auto support = function.GetSupport();
+  double support_begin = std::ldexp(support.first + k, -j);
+  double support_end = std::ldexp(support.second + k, -j);
+
+  auto first = std::lower_bound(sorted_x.begin(), sorted_x.end(), support_begin);
+
+  for(auto x = first; x != sorted_x.end() && *x < support_end; ++x){
+    (*values)[x - sorted_x.begin()] += multiplier * function.GetValue(*x, j, k);
+  }
+}
+
 /** Computes coefficients for the lower resolution.
  * @brief Computes coefficients for the lower resolution.
  */
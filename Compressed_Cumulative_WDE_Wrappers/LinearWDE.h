@@ -9,6 +9,7 @@
 
 #include "WaveletDensityEstimator.h"
 #include "TranslatedDilatedScalingFunction.h"
+#include "TabulatedWaveletFunction.h"
 
 #include <vector>
 
@@ -35,6 +36,7 @@ class LinearWDE : public WaveletDensityEstimator {
               const double &threshold = 1e-5);
 
     double GetValue(const double &x) const override;
+    virtual void AccumulateValues(const vector<double> &sorted_x, vector<double> *values) const;
 
     void UpdateWDEData(const vector<double> &values_block) override;
     void LowerCoefficientsResolution() override;
@@ -56,6 +58,9 @@ class LinearWDE : public WaveletDensityEstimator {
   protected:
 
     static TranslatedDilatedScalingFunction translated_dilated_scaling_function_;
+    // Used for the values of the scaling functions, as it's const and cheaper.
+    std::shared_ptr<const TabulatedWaveletFunction> scaling_function_table_ =
+        TabulatedWaveletFunction::GetScalingFunction();
 
     int scaling_function_resolution_index_ = 0;
     int k_min_ = 0;
@@ -69,6 +74,12 @@ class LinearWDE : public WaveletDensityEstimator {
     virtual void ComputeOptimalResolutionIndex(const vector<StreamElementData> &values_block);
     virtual void ComputeTranslations(const vector<StreamElementData> &values_block);
     virtual void ComputeEmpiricalScalingCoefficients(const vector<StreamElementData> &values);
+    void AccumulateFunctionValues(const vector<double> &sorted_x, const TabulatedWaveletFunction &function,
+                                  const int &j, const int &k, const double &multiplier,
+                                  vector<double> *values) const;
+    vector<double> ComputeWeightedFunctionSums(const vector<StreamElementData> &values,
+                                               const TabulatedWaveletFunction &function, const int &j,
+                                               const int &k_min, const int &k_max) const;
     vector<int> ComputeLowerResolutionTranslations(const int &number_of_filter_coefficients,
                                                    const vector<EmpiricalCoefficientData> &scaling_coefficients) const;
     vector<EmpiricalCoefficientData> ComputeLowerResolutionScalingCoefficients(
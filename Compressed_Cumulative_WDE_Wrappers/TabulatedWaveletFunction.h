@@ -0,0 +1,43 @@
+//
+// Header file for tabulated scaling and wavelet functions. Values of the (mother) function are sampled once, at
+// dyadic points, and translated dilated functions are then evaluated from the table, with linear interpolation.
+// Evaluation doesn't change any state, so tables can be shared between estimators and threads.
+//
+
+#ifndef KERDEP_TABULATEDWAVELETFUNCTION_H
+#define KERDEP_TABULATEDWAVELETFUNCTION_H
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using std::vector;
+
+class TabulatedWaveletFunction {
+  public:
+    TabulatedWaveletFunction(const std::function<double(const double &)> &function, const double &support_min,
+                             const double &support_max, const int &resolution_index);
+
+    double GetValue(const double &x) const;
+    double GetValue(const double &x, const int &j, const int &k) const;
+    std::pair<double, double> GetSupport() const;
+    std::pair<int, int> GetTranslationsRange(const double &x, const int &j) const;
+    int GetResolutionIndex() const;
+
+    static std::shared_ptr<const TabulatedWaveletFunction> GetScalingFunction();
+    static std::shared_ptr<const TabulatedWaveletFunction> GetWaveletFunction();
+    static void SetDefaultResolutionIndex(const int &resolution_index);
+    static int GetDefaultResolutionIndex();
+
+  protected:
+    double support_min_ = 0;
+    double support_max_ = 0;
+    int resolution_index_ = 0;
+    double samples_per_unit_ = 1; // 2^resolution_index_.
+    vector<double> values_ = {};
+
+    static std::shared_ptr<const TabulatedWaveletFunction> GetFunction(const bool &is_wavelet);
+};
+
+#endif //KERDEP_TABULATEDWAVELETFUNCTION_H
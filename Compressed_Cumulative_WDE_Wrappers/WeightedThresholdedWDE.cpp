@@ -23,32 +23,105 @@ void WeightedThresholdedWDE::ComputeEmpiricalWaveletCoefficients(const vector<St
 
   empirical_wavelet_coefficients_ = {};
 
-  if(values.empty()){
+  if(values.empty() || resolution_index_1_ < scaling_function_resolution_index_){
     return;
   }
 
-  for(int j = scaling_function_resolution_index_; j <= resolution_index_1_; ++j) {
-    for(int k = k_min_; k <= k_max_; ++k) {
+  auto filter_coefficients = translated_dilated_scaling_function_.GetFilterCoefficients();
+  int filter_length = filter_coefficients.size();
+
+  // Translations of the scaling coefficients needed on each level, from the coarsest one. Details on level j need
+  // scaling coefficients of level j + 1 with l in [2k + 2 - L, 2k + 1], and these need the ones of level j + 2 with
+  // l in [2k, 2k + L - 1].
+  int levels_number = resolution_index_1_ - scaling_function_resolution_index_ + 1;
+  vector<std::pair<int, int>> scaling_translations(levels_number + 1);
+  scaling_translations[0] = {k_min_, k_min_ - 1}; // Coarsest scaling coefficients aren't needed.
+
+  for(int level = 1; level <= levels_number; ++level){
+    auto coarser_translations = scaling_translations[level - 1];
+    std::pair<int, int> translations = {2 * k_min_ + 2 - filter_length, 2 * k_max_ + 1};
+
+    if(coarser_translations.first <= coarser_translations.second){
+      translations.first = std::min(translations.first, 2 * coarser_translations.first);
+      translations.second = std::max(translations.second, 2 * coarser_translations.second + filter_length - 1);
+    }
 
-      double coefficient = 0;
+    scaling_translations[level] = translations;
+  }
 
-      translated_dilated_wavelet_function_.UpdateIndices(j, k);
+  // Finest scaling coefficients are computed from the block, the rest is derived from them.
+  auto finest_translations = scaling_translations[levels_number];
+  auto scaling_coefficients = ComputeWeightedFunctionSums(values, *scaling_function_table_, resolution_index_1_ + 1,
+                                                          finest_translations.first, finest_translations.second);
 
-      for(auto val : values) {
-        coefficient += translated_dilated_wavelet_function_.GetValue(val.value_) * val.weight_;
-      }
+  for(auto &coefficient : scaling_coefficients){
+    coefficient /= weights_sum_;
+  }
+
+  vector<vector<double>> wavelet_coefficients(levels_number);
 
-      coefficient /= weights_sum_;
+  for(int level = levels_number - 1; level >= 0; --level){
+    int l_min = scaling_translations[level + 1].first;
 
+    wavelet_coefficients[level] = ApplyFilter(scaling_coefficients, l_min, filter_coefficients, k_min_, k_max_, true);
+    scaling_coefficients = ApplyFilter(scaling_coefficients, l_min, filter_coefficients,
+                                       scaling_translations[level].first, scaling_translations[level].second, false);
+  }
+
+  for(int level = 0; level < levels_number; ++level){
+    for(int k = k_min_; k <= k_max_; ++k) {
       EmpiricalCoefficientData data;
-      data.coefficient_ = coefficient;
-      data.j_ = j;
+      data.coefficient_ = wavelet_coefficients[level][k - k_min_];
+      data.j_ = scaling_function_resolution_index_ + level;
       data.k_ = k;
       empirical_wavelet_coefficients_.push_back(data);
     }
   }
 }
 
+/** Computes coefficients of lower resolution from scaling coefficients with the filter bank (a step of Mallat's
+ * pyramid), as in ComputeLowerResolutionScalingCoefficients and ComputeLowerResolutionWaveletCoefficients.
+ * @brief Computes coefficients of lower resolution from scaling coefficients with the filter bank.
+ * @param scaling_coefficients - Scaling coefficients, l_min first.
+ * @param l_min - Translation of the first scaling coefficient. Missing ones are treated as 0.
+ * @param filter_coefficients - Scaling filter coefficients.
+ * @param k_min - First translation of computed coefficients.
+ * @param k_max - Last translation of computed coefficients.
+ * @param is_wavelet_filter - If true, wavelet (detail) coefficients are computed, scaling ones otherwise.
+ * @return Coefficients, k_min first.
+ */
+vector<double> WeightedThresholdedWDE::ApplyFilter(const vector<double> &scaling_coefficients, const int &l_min,
+                                                   const vector<double> &filter_coefficients, const int &k_min,
+                                                   const int &k_max, const bool &is_wavelet_filter) const {
+  vector<double> coefficients(std::max(k_max - k_min + 1, 0), 0.0);
+  int l_max = l_min + (int) scaling_coefficients.size() - 1;
+
+  for(int k = k_min; k <= k_max; ++k){
+    double coefficient = 0;
+
+    for(int i = 0; i < filter_coefficients.size(); ++i){
+      // Scaling: index = l - 2k. Wavelet: index = -l + 2k + 1, with (-1)^l sign.
+      int l = is_wavelet_filter ? 2 * k + 1 - i : 2 * k + i;
+
+      if(l < l_min || l > l_max){
+        continue;
+      }
+
+      double addend = filter_coefficients[i] * scaling_coefficients[l - l_min];
+
+      if(is_wavelet_filter && l % 2 != 0){
+        addend = -addend;
+      }
+
+      coefficient += addend;
+    }
+
+    coefficients[k - k_min] = coefficient;
+  }
+
+  return coefficients;
+}
+
 void WeightedThresholdedWDE::RemoveSmallestWaveletCoefficients(const unsigned int &number_of_coefficients) {
 
   if(number_of_coefficients == 0 || number_of_coefficients >= empirical_wavelet_coefficients_.size()){
@@ -134,13 +207,27 @@ double WeightedThresholdedWDE::GetValue(const double &x) const {
   return val;
 }
 
+/** Adds values of the estimator in the points of sorted grid to the values, as GetValue would compute them.
+ * @brief Adds values of the estimator in the points of sorted grid to the values.
+ * @param sorted_x - Points, in ascending order.
+ * @param values - Values in the points, to which values of the estimator are added.
+ */
+void WeightedThresholdedWDE::AccumulateValues(const vector<double> &sorted_x, vector<double> *values) const {
+
+  WeightedLinearWDE::AccumulateValues(sorted_x, values);
+
+  for(const auto &val : empirical_wavelet_coefficients_){
+    AccumulateFunctionValues(sorted_x, *wavelet_function_table_, val.j_, val.k_,
+                             thresholding_strategy_->ComputeThresholdedCoefficient(val), values);
+  }
+}
+
 double WeightedThresholdedWDE::ComputeWaveletAddend(const double &x) const {
 
   double wavelet_addend = 0;
 
-  for(auto val : empirical_wavelet_coefficients_){
-    translated_dilated_wavelet_function_.UpdateIndices(val.j_, val.k_);
-    wavelet_addend += thresholding_strategy_->ComputeThresholdedCoefficient(val) * translated_dilated_wavelet_function_.GetValue(x);
+  for(const auto &val : empirical_wavelet_coefficients_){
+    wavelet_addend += thresholding_strategy_->ComputeThresholdedCoefficient(val) * wavelet_function_table_->GetValue(x, val.j_, val.k_);
   }
 
   return wavelet_addend;
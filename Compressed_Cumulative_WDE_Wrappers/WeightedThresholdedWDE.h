@@ -18,6 +18,7 @@ class WeightedThresholdedWDE : public WeightedLinearWDE {
 
 
     double GetValue(const double &x) const override;
+    void AccumulateValues(const vector<double> &sorted_x, vector<double> *values) const override;
     void UpdateWDEData(const vector<double> &values_block) override;
     void LowerCoefficientsResolution() override;
     unsigned int GetEmpiricalWaveletCoefficientsNumber() const override;
@@ -26,6 +27,8 @@ class WeightedThresholdedWDE : public WeightedLinearWDE {
   protected:
 
     static TranslatedDilatedWaveletFunction translated_dilated_wavelet_function_;
+    std::shared_ptr<const TabulatedWaveletFunction> wavelet_function_table_ =
+        TabulatedWaveletFunction::GetWaveletFunction();
     ThresholdingStrategyPtr thresholding_strategy_;
     vector<EmpiricalCoefficientData> empirical_wavelet_coefficients_ = {};
 
@@ -33,6 +36,9 @@ class WeightedThresholdedWDE : public WeightedLinearWDE {
 
     void ComputeOptimalResolutionIndex(const vector<StreamElementData> &values_block) override;
     virtual void ComputeEmpiricalWaveletCoefficients(const vector<StreamElementData> &values);
+    vector<double> ApplyFilter(const vector<double> &scaling_coefficients, const int &l_min,
+                               const vector<double> &filter_coefficients, const int &k_min, const int &k_max,
+                               const bool &is_wavelet_filter) const;
     double ComputeWaveletAddend(const double &x) const;
     vector<EmpiricalCoefficientData> ComputeLowerResolutionWaveletCoefficients(
         const vector<EmpiricalCoefficientData> &coefficients) const;
@@ -4,8 +4,10 @@
 
 #include "kerDepCcWde.h"
 #include "TranslatedDilatedScalingFunction.h"
+#include "LinearWDE.h"
 
 #include <algorithm>
+#include <numeric>
 
 #include "math_helpers.h"
 
@@ -36,12 +38,59 @@ vector<point> KerDEP_CC_WDE::GetErrorDomain() const {
   return GetErrorDomainFromCoefficients();
 }
 
+/** Computes values of the estimator on the domain.
+ *
+ * If all the components are linear WDEs (or derived from them), their values are accumulated on the sorted domain in
+ * one sweep per component, each of which only visits the points within supports of its coefficients. Otherwise the
+ * values are computed point by point.
+ *
+ * @brief Computes values of the estimator on the domain.
+ * @param domain - Points (1D) in which the values are computed.
+ * @return Values of the estimator, in the order of the domain.
+ */
 std::vector<double> KerDEP_CC_WDE::GetEstimatorValuesOnDomain(std::vector<point> domain) const {
   vector<double> estimator_values_on_domain = {};
 
-  for(const point& pt : domain){
-    double value_on_pt = GetValue(pt);
-    estimator_values_on_domain.push_back(value_on_pt);
+  bool can_values_be_accumulated = !estimators_.empty();
+
+  for(const auto &estimator : estimators_){
+    if(dynamic_cast<const LinearWDE*>(&*estimator) == nullptr){
+      can_values_be_accumulated = false;
+      break;
+    }
+  }
+
+  if(!can_values_be_accumulated){
+    for(const point& pt : domain){
+      double value_on_pt = GetValue(pt);
+      estimator_values_on_domain.push_back(value_on_pt);
+    }
+
+    return estimator_values_on_domain;
+  }
+
+  vector<size_t> order(domain.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&domain](const size_t &first, const size_t &second) {
+    return domain[first][0] < domain[second][0];
+  });
+
+  vector<double> sorted_x = {};
+
+  for(auto i : order){
+    sorted_x.push_back(domain[i][0]);
+  }
+
+  vector<double> sorted_values(sorted_x.size(), 0.0);
+
+  for(const auto &estimator : estimators_){
+    dynamic_cast<const LinearWDE*>(&*estimator)->AccumulateValues(sorted_x, &sorted_values);
+  }
+
+  estimator_values_on_domain.resize(domain.size());
+
+  for(size_t i = 0; i < order.size(); ++i){
+    estimator_values_on_domain[order[i]] = sorted_values[i];
   }
 
   return estimator_values_on_domain;
@@ -59,17 +59,12 @@ void WeightedLinearWDE::ComputeEmpiricalScalingCoefficients(const vector<StreamE
     return;
   }
 
-  for(int k = k_min_; k <= k_max_; ++k){
-
-    double coefficient = 0;
+  auto sums = ComputeWeightedFunctionSums(values, *scaling_function_table_, scaling_function_resolution_index_,
+                                          k_min_, k_max_);
 
-    translated_dilated_scaling_function_.UpdateIndices(scaling_function_resolution_index_, k);
-
-    for(auto val : values){
-      coefficient += translated_dilated_scaling_function_.GetValue(val.value_) * val.weight_;
-    }
+  for(int k = k_min_; k <= k_max_; ++k){
 
-    coefficient /= weights_sum_;
+    double coefficient = sums[k - k_min_] / weights_sum_;
 
     EmpiricalCoefficientData data;
     data.coefficient_ = coefficient;
@@ -1,12 +1,18 @@
 #include "DESDA.h"
 #include "KDE/pluginsmoothingparametercounter.h"
+#include "KDE/smoothingParameterScheduler.h"
+#include "KDE/clusterKernelMatrixCache.h"
+#include "Benchmarking/stepProfiler.h"
 
 #include <QTime>
 #include <QCoreApplication>
 #include <QRandomGenerator>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <fstream>
 #include <math.h>
+#include <unordered_set>
 
 # define M_PI           3.14159265358979323846  /* pi */
 
@@ -101,18 +107,92 @@ double average(std::vector<double> values) {
 }
 
 void DESDA::performStep() {
-  // Making place for new cluster
-  while(_clustersForWindowed.size() >= _maxM) {
-    _clustersForWindowed.pop_back();
-    _objects.erase(_objects.begin(), _objects.begin() + 1);
+  KERDEP_PROFILE_STEP_BEGIN(_stepNumber);
+
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kStep);
+
+    ingestElement();
+    refreshEstimator();
   }
 
-  while(_clusters->size() > _m) {
-    _clusters->pop_back();
+  KERDEP_PROFILE_STEP_END();
+}
+
+/** DESDA::performSteps
+ * @brief Performs steps for a batch of elements, refreshing the estimator only
+ * once, after the last of them.
+ *
+ * Each element is ingested exactly as in performStep: it's moved through the
+ * reservoir, inserted as a cluster and added to the stationarity tests, so KPSS,
+ * sgmKPSS, beta0, m and v follow every element. Only the refresh of the estimator
+ * (smoothing parameters, weights, KDE, prognosis and derivatives on clusters,
+ * max |a| and derivatives histories and r) is done once per batch. Hence the
+ * prognosis of clusters and the histories advance once per batch instead of once
+ * per element, and the estimator reflects the state after the last element of
+ * the batch. performSteps(1) is equivalent to performStep().
+ *
+ * @param elementsNumber - Maximal number of elements in the batch.
+ * @param latencyBudget - If positive, time in ms the whole batch should fit in.
+ * Elements are ingested as long as the time spent on the batch, together with
+ * the duration of the last refresh, is within the budget. At least one element
+ * is always ingested.
+ * @return Number of ingested elements.
+ */
+int DESDA::performSteps(int elementsNumber, double latencyBudget) {
+  auto batchStart = std::chrono::steady_clock::now();
+  int ingestedElementsNumber = 0;
+
+  KERDEP_PROFILE_STEP_BEGIN(_stepNumber);
+
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kStep);
+
+    do {
+      ingestElement();
+      ++ingestedElementsNumber;
+    } while(ingestedElementsNumber < elementsNumber
+            && (latencyBudget <= 0 || std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - batchStart).count() + _lastRefreshDuration < latencyBudget));
+
+    auto refreshStart = std::chrono::steady_clock::now();
+    refreshEstimator();
+    _lastRefreshDuration =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - refreshStart).count();
   }
 
-  // Reservoir movement
-  _samplingAlgorithm->performSingleStep(&_objects, _stepNumber);
+  KERDEP_PROFILE_STEP_END();
+
+  return ingestedElementsNumber;
+}
+
+/** DESDA::ingestElement
+ * @brief Moves the next element of the stream through the reservoir, inserts it
+ * as a new cluster and updates the stationarity tests and the parameters that
+ * depend only on them (sgmKPSS, beta0, m and v). Estimator isn't refreshed.
+ * With background grouping, published medoids are applied first.
+ */
+void DESDA::ingestElement() {
+  // Before anything reads the clusters, so the whole step works on one set.
+  if(_groupingThread) updateStoredMedoids();
+
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kReservoirMovement);
+
+    // Making place for new cluster
+    while(_clustersForWindowed.size() >= _maxM) {
+      _clustersForWindowed.pop_back();
+      _objects.erase(_objects.begin(), _objects.begin() + 1);
+    }
+
+    while(_clusters->size() > _m) {
+      if(_kernelMatrixCache) _kernelMatrixCache->removeCluster(_clusters->back());
+      _clusters->pop_back();
+    }
+
+    // Reservoir movement
+    _samplingAlgorithm->performSingleStep(&_objects, _stepNumber);
+  }
 
   std::shared_ptr<cluster> newCluster =
       std::shared_ptr<cluster>(new cluster(_stepNumber, _objects.back()));
@@ -133,14 +213,18 @@ void DESDA::performStep() {
   }
    */
 
-  for(int i = 0; i < stationarityTests.size(); ++i) {
-    std::string attribute = (*newCluster->getObject()->attirbutesOrder)[i];
-    stationarityTests[i]->addNewSample(std::stod(newCluster->getObject()->attributesValues[attribute]));
-  }
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kStationarityTest);
 
+    for(int i = 0; i < stationarityTests.size(); ++i) {
+      std::string attribute = (*newCluster->getObject()->attirbutesOrder)[i];
+      stationarityTests[i]->addNewSample(std::stod(newCluster->getObject()->attributesValues[attribute]));
+    }
+
+    _sgmKPSS = sigmoid(_sgmKPSSParameters[_sgmKPSSPercent][0] * getStationarityTestValue()
+                       - _sgmKPSSParameters[_sgmKPSSPercent][1]);
+  }
 
-  _sgmKPSS = sigmoid(_sgmKPSSParameters[_sgmKPSSPercent][0] * getStationarityTestValue()
-                     - _sgmKPSSParameters[_sgmKPSSPercent][1]);
   _d = _sgmKPSS;
 
   // Beta0 update
@@ -156,28 +240,108 @@ void DESDA::performStep() {
   _v = _m > _clusters->size() ? 1.0 - 1.0 / _clusters->size() : 1.0 - 1.0 / _m;
   cluster::_deactualizationParameter = _v;
 
-  // Calculate smoothing parameterers
-  _windowedSmoothingParametersVector = calculateH(*_clusters);
+  if(_smoothingParameterScheduler) {
+    std::vector<double> newValues = {};
+
+    for(auto attribute: *_samplingAlgorithm->getAttributesList()) {
+      newValues.push_back(std::stod(newCluster->getRepresentative()->attributesValues[attribute]));
+    }
+
+    _smoothingParameterScheduler->addSample(newValues, _v);
+    _windowedSmoothingParameterScheduler->addSample(newValues, 1.0 - 1.0 / _clusters->size());
+  }
+
+  ++_stepNumber;
+}
+
+/** DESDA::refreshEstimator
+ * @brief Recomputes what the predictions of clusters (and thus the next steps)
+ * depend on: smoothing parameters, weights, KDE on clusters, prognosis, max |a|
+ * history and r.
+ *
+ * Products that are only read by queries, i.e. windowed smoothing parameters,
+ * derivatives on clusters and the derivatives maxima, are only marked dirty here
+ * and materialized by the first query that needs them. Their values are the same
+ * as if they were computed right away, but the history of max |derivative| gets
+ * a new entry per materialization instead of per step.
+ */
+void DESDA::refreshEstimator() {
   auto currentClusters = getClustersForEstimator();
-  _smoothingParametersVector = calculateH(currentClusters);
+
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kSmoothingParameter);
+    _smoothingParametersVector = scheduleH(_smoothingParameterScheduler.get(), currentClusters);
+    if(_kernelMatrixCache) _kernelMatrixCache->setSmoothingParameters(_smoothingParametersVector);
+  }
 
   // Update weights
-  updateWeights();
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kWeightsUpdate);
+    updateWeights();
+  }
 
-  qDebug() << "Reservoir size in step " << _stepNumber
+  qDebug() << "Reservoir size in step " << _stepNumber - 1
            << " is: " << currentClusters.size() << ".";
 
   // Update clusters prognosis
-  countKDEValuesOnClusters();
-  updatePrognosisParameters();
-  countDerivativeValuesOnClusters();
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kKDEOnClusters);
+    countKDEValuesOnClusters();
+  }
+
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kPrognosisUpdate);
+    updatePrognosisParameters();
+  }
 
   // Update a
-  updateMaxAbsAVector();
-  updateMaxAbsDerivativeVector();
-  updateMaxAbsDerivativeInCurrentStep();
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kMaxAbsUpdates);
+    updateMaxAbsAVector();
+  }
+
+  // Update uncommon elements
+  _r = 0.01 + 0.09 * _sgmKPSS;
+
+  _areWindowedSmoothingParametersDirty = true;
+  _areDerivativesDirty = true;
+}
+
+/** DESDA::materializeWindowedSmoothingParameters
+ * @brief Computes windowed smoothing parameters, if they're outdated. They're
+ * used by windowed KDE and as domain bounds of all the estimators.
+ */
+void DESDA::materializeWindowedSmoothingParameters() {
+  if(!_areWindowedSmoothingParametersDirty) return;
+
+  KERDEP_PROFILE_SCOPE(ProfiledPhase::kWindowedSmoothingParameter);
+  _windowedSmoothingParametersVector = scheduleH(_windowedSmoothingParameterScheduler.get(), *_clusters);
+  _areWindowedSmoothingParametersDirty = false;
+}
+
+/** DESDA::materializeDerivatives
+ * @brief Computes derivatives on clusters and their maxima, if they're outdated.
+ * They're used by prediction enhanced and atypical elements estimators.
+ */
+void DESDA::materializeDerivatives() {
+  if(!_areDerivativesDirty) return;
+
+  _areDerivativesDirty = false;
+
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kDerivativeOnClusters);
+    countDerivativeValuesOnClusters();
+  }
+
+  {
+    KERDEP_PROFILE_SCOPE(ProfiledPhase::kMaxAbsUpdates);
+    updateMaxAbsDerivativeVector();
+    updateMaxAbsDerivativeInCurrentStep();
+  }
 
+  auto currentClusters = getClustersForEstimator();
   _examinedClustersDerivatives.clear();
+
   for(auto index : _examinedClustersIndices) {
     if(index < 0) {
       _examinedClustersDerivatives.push_back(0);
@@ -186,11 +350,6 @@ void DESDA::performStep() {
       _examinedClustersDerivatives.push_back(currentClusters[index]->_currentDerivativeValue);
     }
   }
-
-  // Update uncommon elements
-  _r = 0.01 + 0.09 * _sgmKPSS;
-
-  ++_stepNumber;
 }
 
 void DESDA::updateWeights() {
@@ -300,6 +459,18 @@ void DESDA::countKDEValuesOnClusters() {
   auto consideredClusters = getClustersForEstimator();
   _estimator->setClusters(consideredClusters);
 
+  if(_isIncrementalKDEOnClustersEnabled) {
+    countKDEValuesOnClustersIncrementally(consideredClusters);
+    return;
+  }
+
+  if(_kernelMatrixCache) {
+    for(auto c : *_clusters)
+      c->_currentKDEValue = getCachedKDEValueOnCluster(c, consideredClusters, _estimator->_shouldConsiderWeights);
+
+    return;
+  }
+
   _estimator->setSmoothingParameters(_smoothingParametersVector);
 
   for(std::shared_ptr<cluster> c : *_clusters) {
@@ -312,6 +483,302 @@ void DESDA::countKDEValuesOnClusters() {
   }
 }
 
+/** DESDA::setIncrementalKDEOnClusters
+ * @brief Enables (or disables) incremental computation of KDE values on
+ * clusters.
+ *
+ * Each cluster keeps sums s0 and s1 of the kernels of window clusters, the
+ * latter weighted by their positions j in the window. Weights of the clusters
+ * are linear in the position (w_j = 2 - 2 * sgmKPSS * j / m), so the weighted
+ * KDE value is (2 s0 - 2 sgmKPSS s1 / m) / (2m - sgmKPSS (m - 1)) / h. Between
+ * refreshes, clusters enter the window at the front and leave it at the back,
+ * so the sums are updated by the terms of these clusters only, which makes the
+ * refresh linear instead of quadratic in m.
+ *
+ * Sums are computed with smoothing parameters of the last full recompute. They
+ * are recomputed from scratch when current smoothing parameters differ from
+ * these by more than tolerance (relative), when the window changed by more than
+ * half or after maxRefreshesBetweenFullRecomputes refreshes, to bound rounding
+ * errors. With tolerance 0, values only differ from the full computation by
+ * rounding.
+ */
+void DESDA::setIncrementalKDEOnClusters(bool isEnabled, double tolerance, int maxRefreshesBetweenFullRecomputes) {
+  _isIncrementalKDEOnClustersEnabled = isEnabled;
+  _incrementalKDETolerance = tolerance;
+  _maxRefreshesBetweenFullKDERecomputes = maxRefreshesBetweenFullRecomputes;
+
+  _kdePartialSums.clear();
+  _kdePartialSumsWindow.clear();
+  _kdePartialSumsSmoothingParameters.clear();
+}
+
+/** DESDA::setKernelMatrixCaching
+ * @brief Enables (or disables) caching of kernel values between pairs of
+ * clusters. KDE and derivative values on clusters and accelerated KDE values
+ * used for atypical elements all evaluate kernels between the same pairs of
+ * clusters with the same smoothing parameters, so with the cache each pair is
+ * evaluated once per change of h. Values are the same as without it. Assumes
+ * that all the estimators have the same kernels, as they're generated the same
+ * way.
+ */
+void DESDA::setKernelMatrixCaching(bool isEnabled) {
+  _kernelMatrixCache.reset();
+
+  if(!isEnabled) return;
+
+  _kernelMatrixCache.reset(new clusterKernelMatrixCache(*_estimator, 2 * _clusters->size() + 1));
+  _kernelMatrixCache->setSmoothingParameters(_smoothingParametersVector);
+}
+
+/** DESDA::setBackgroundGrouping
+ * @brief Enables grouping of the clusters into stored medoids concurrently with
+ * the stream. Every stepsBetweenGroupings steps the thread gets a snapshot of the
+ * clusters (unless it's still grouping the previous one), and medoids it
+ * publishes are applied at the start of the following ingestions. Thread may
+ * store medoids in the clusters themselves, as in the experiments, see
+ * applyPublishedMedoids.
+ * @param thread - Initialized grouping thread storing medoids in the stored
+ * medoids or in the clusters of DESDA, or nullptr to disable.
+ */
+void DESDA::setBackgroundGrouping(groupingThread *thread, int stepsBetweenGroupings) {
+  _groupingThread = thread;
+  _stepsBetweenGroupings = std::max(stepsBetweenGroupings, 1);
+  _storedMedoidsEpoch = 0;
+
+  if(_groupingThread) applyPublishedMedoids();
+}
+
+/** DESDA::getStoredMedoidsEpoch
+ * @brief Returns epoch of the stored medoids, i.e. number of medoids sets
+ * published by the grouping thread, when they were last applied.
+ */
+unsigned long long DESDA::getStoredMedoidsEpoch() {
+  return _storedMedoidsEpoch;
+}
+
+/** DESDA::updateStoredMedoids
+ * @brief Applies medoids published since the last step and schedules the next
+ * grouping. Neither waits for the grouping.
+ */
+void DESDA::updateStoredMedoids() {
+  applyPublishedMedoids();
+
+  if(_stepNumber % _stepsBetweenGroupings == 0) {
+    _groupingThread->groupClustersInBackground(*_clusters);
+  }
+}
+
+/** DESDA::applyPublishedMedoids
+ * @brief Applies the last medoids set published by the grouping thread, if it
+ * wasn't applied yet. If the thread stores medoids in the clusters, they are
+ * replaced by the set, so what was kept for the replaced clusters is dropped.
+ */
+void DESDA::applyPublishedMedoids() {
+  if(_groupingThread->getMedoidsEpoch() == _storedMedoidsEpoch) return;
+
+  if(_groupingThread->getMedoidsStorage() != _clusters) {
+    _storedMedoidsEpoch = _groupingThread->applyPublishedMedoids();
+    return;
+  }
+
+  std::vector<std::shared_ptr<cluster>> replacedClusters = *_clusters;
+  _storedMedoidsEpoch = _groupingThread->applyPublishedMedoids();
+  forgetReplacedClusters(replacedClusters);
+}
+
+/** DESDA::forgetReplacedClusters
+ * @brief Drops kernel values of the replaced clusters from the cache and the
+ * partial sums of incremental KDE, which are then recomputed on the next
+ * refresh. Lazy products were computed on the replaced clusters, so they're
+ * marked dirty.
+ * @param replacedClusters - Clusters before the replacement.
+ */
+void DESDA::forgetReplacedClusters(const std::vector<std::shared_ptr<cluster>> &replacedClusters) {
+  std::unordered_set<cluster*> currentClusters = {};
+
+  for(auto c : *_clusters) currentClusters.insert(c.get());
+
+  if(_kernelMatrixCache) {
+    for(auto c : replacedClusters) {
+      if(currentClusters.count(c.get()) == 0) _kernelMatrixCache->removeCluster(c);
+    }
+  }
+
+  _kdePartialSums.clear();
+  _kdePartialSumsWindow.clear();
+
+  _areWindowedSmoothingParametersDirty = true;
+  _areDerivativesDirty = true;
+}
+
+/** DESDA::getCachedKDEValueOnCluster
+ * @brief Counts value of KDE built on given clusters on given cluster, as
+ * kernelDensityEstimator would, but with kernel values from the cache.
+ * @param multipliers - Additional multipliers of addends, used if there's one
+ * per cluster.
+ * @param skippedIndex - Index of the cluster to leave out, if not negative.
+ * Clusters are then summed starting from the next one, as in accelerated KDE.
+ */
+double DESDA::getCachedKDEValueOnCluster(const std::shared_ptr<cluster> &c,
+                                         const std::vector<std::shared_ptr<cluster>> &clusters,
+                                         bool shouldConsiderWeights, const std::vector<double> &multipliers,
+                                         int skippedIndex) {
+  double result = 0, weight = 0;
+  int n = clusters.size();
+  int first = skippedIndex < 0 ? 0 : skippedIndex + 1;
+  int addendsNumber = skippedIndex < 0 ? n : n - 1;
+  bool shouldUseMultipliers = multipliers.size() == clusters.size();
+
+  for(int k = 0; k < addendsNumber; ++k) {
+    int j = (first + k) % n;
+    double addend = _kernelMatrixCache->getKernelValue(c, clusters[j]);
+
+    if(shouldConsiderWeights) {
+      addend *= clusters[j]->getCWeight();
+      weight += clusters[j]->getCWeight();
+    } else {
+      weight += 1;
+    }
+
+    if(shouldUseMultipliers) addend *= multipliers[j];
+
+    result += addend;
+  }
+
+  for(double h : _smoothingParametersVector)
+    result /= h;
+
+  return result / weight;
+}
+
+bool DESDA::shouldRecomputeKDEPartialSums() {
+  if(_kdePartialSumsSmoothingParameters.size() != _smoothingParametersVector.size()) return true;
+  if(_refreshesSinceFullKDERecompute >= _maxRefreshesBetweenFullKDERecomputes) return true;
+
+  for(size_t i = 0; i < _smoothingParametersVector.size(); ++i) {
+    double ratio = _smoothingParametersVector[i] / _kdePartialSumsSmoothingParameters[i];
+    if(!std::isfinite(ratio) || fabs(ratio - 1.0) > _incrementalKDETolerance) return true;
+  }
+
+  return false;
+}
+
+/** DESDA::countKDEValuesOnClustersIncrementally
+ * @brief Updates partial sums of kernels of each cluster with the clusters that
+ * entered or left the window since the last refresh and counts KDE values on
+ * clusters from them. See setIncrementalKDEOnClusters.
+ */
+void DESDA::countKDEValuesOnClustersIncrementally(const std::vector<std::shared_ptr<cluster>> &consideredClusters) {
+  if(consideredClusters.empty()) return;
+
+  bool shouldRecompute = shouldRecomputeKDEPartialSums();
+
+  // Find clusters that entered and left the window. Positions of the clusters
+  // that stayed should all be shifted by the number of new clusters.
+  std::unordered_map<cluster*, int> previousPositions = {};
+  std::unordered_map<cluster*, int> currentPositions = {};
+  std::vector<int> enteredPositions = {};
+  std::vector<int> leftPositions = {};
+  int shift = -1;
+
+  for(size_t j = 0; j < _kdePartialSumsWindow.size(); ++j)
+    previousPositions[_kdePartialSumsWindow[j].get()] = j;
+
+  for(size_t j = 0; j < consideredClusters.size(); ++j) {
+    currentPositions[consideredClusters[j].get()] = j;
+    auto previousPosition = previousPositions.find(consideredClusters[j].get());
+
+    if(previousPosition == previousPositions.end()) enteredPositions.push_back(j);
+    else if(shift < 0) shift = j - previousPosition->second;
+    else if(shift != j - previousPosition->second) shouldRecompute = true;
+  }
+
+  for(size_t j = 0; j < _kdePartialSumsWindow.size(); ++j) {
+    if(currentPositions.find(_kdePartialSumsWindow[j].get()) == currentPositions.end())
+      leftPositions.push_back(j);
+  }
+
+  if(shift < 0 || 2 * (enteredPositions.size() + leftPositions.size()) > consideredClusters.size())
+    shouldRecompute = true;
+
+  if(shouldRecompute) {
+    _kdePartialSumsSmoothingParameters = _smoothingParametersVector;
+    _refreshesSinceFullKDERecompute = 0;
+    _kdePartialSums.clear();
+  } else {
+    ++_refreshesSinceFullKDERecompute;
+  }
+
+  _estimator->setSmoothingParameters(_kdePartialSumsSmoothingParameters);
+
+  std::unordered_map<std::shared_ptr<cluster>, kdePartialSums> partialSums = {};
+
+  for(auto c : *_clusters) {
+    auto previousSums = _kdePartialSums.find(c);
+
+    if(previousSums != _kdePartialSums.end()) {
+      partialSums[c] = previousSums->second;
+      continue;
+    }
+
+    // Clusters hold single elements, so their representative is both the point
+    // the KDE is counted on and the center of their kernel.
+    auto &sums = partialSums[c];
+    for(auto attribute: *c->getRepresentative()->attirbutesOrder)
+      sums.x.push_back(std::stod(c->getRepresentative()->attributesValues[attribute]));
+  }
+
+  for(auto c : *_clusters) {
+    auto &sums = partialSums[c];
+
+    if(_kdePartialSums.find(c) == _kdePartialSums.end()) {
+      // New cluster (or full recompute), sum over the whole window.
+      for(size_t j = 0; j < consideredClusters.size(); ++j) {
+        double kernel = _estimator->getProductKernelAddendFromSample(&partialSums[consideredClusters[j]].x, &sums.x);
+        sums.s0 += kernel;
+        sums.s1 += j * kernel;
+      }
+
+      continue;
+    }
+
+    for(auto j : leftPositions) {
+      double kernel = _estimator->getProductKernelAddendFromSample(&_kdePartialSums[_kdePartialSumsWindow[j]].x,
+                                                                    &sums.x);
+      sums.s0 -= kernel;
+      sums.s1 -= j * kernel;
+    }
+
+    sums.s1 += shift * sums.s0;
+
+    for(auto j : enteredPositions) {
+      double kernel = _estimator->getProductKernelAddendFromSample(&partialSums[consideredClusters[j]].x, &sums.x);
+      sums.s0 += kernel;
+      sums.s1 += j * kernel;
+    }
+  }
+
+  _kdePartialSums = std::move(partialSums);
+  _kdePartialSumsWindow = consideredClusters;
+
+  double m = consideredClusters.size();
+  double smoothingParametersProduct = 1;
+
+  for(auto h : _kdePartialSumsSmoothingParameters)
+    smoothingParametersProduct *= h;
+
+  for(auto c : *_clusters) {
+    auto &sums = _kdePartialSums[c];
+
+    if(_estimator->_shouldConsiderWeights) {
+      c->_currentKDEValue = (2 * sums.s0 - 2 * _sgmKPSS * sums.s1 / m) / (2 * m - _sgmKPSS * (m - 1))
+                            / smoothingParametersProduct;
+    } else {
+      c->_currentKDEValue = sums.s0 / m / smoothingParametersProduct;
+    }
+  }
+}
+
 void DESDA::updatePrognosisParameters() {
   for(std::shared_ptr<cluster> c : *_clusters)
     c->updatePrediction();
@@ -322,6 +789,11 @@ void DESDA::updatePrognosisParameters() {
  *  assings them to clusters.
  */
 void DESDA::countDerivativeValuesOnClusters() {
+  if(_kernelMatrixCache) {
+    countCachedDerivativeValuesOnClusters();
+    return;
+  }
+
   // Get the domain. Formally only m would be needed, but it will not hurt
   // to count on whole domain.
   QVector<double> domain = {};
@@ -335,6 +807,36 @@ void DESDA::countDerivativeValuesOnClusters() {
     (*_clusters)[i]->_currentDerivativeValue = derivativeValues[i];
 }
 
+/** DESDA::countCachedDerivativeValuesOnClusters
+ * @brief Does the same as countDerivativeValuesOnClusters (on 1D data), but
+ * with kernel values from the cache.
+ */
+void DESDA::countCachedDerivativeValuesOnClusters() {
+  materializeWindowedSmoothingParameters();
+
+  auto currentClusters = getClustersForEstimator();
+  std::vector<double> prognosisCoefficients = {};
+
+  for(auto c : currentClusters)
+    prognosisCoefficients.push_back(c->predictionParameters[1]);
+
+  std::vector<double> attributesValues = getAttributesValuesFromClusters(currentClusters, 0);
+  double domainMinValue = getDomainMinValue(attributesValues, _windowedSmoothingParametersVector[0]);
+  double domainMaxValue = getDomainMaxValue(attributesValues, _windowedSmoothingParametersVector[0]);
+
+  for(auto c : *_clusters) {
+    double x = std::stod(c->getObject()->attributesValues["Val0"]);
+
+    if(x > domainMinValue && x < domainMaxValue) {
+      c->_currentDerivativeValue =
+          getCachedKDEValueOnCluster(c, currentClusters, _estimatorDerivative->_shouldConsiderWeights,
+                                     prognosisCoefficients) * 10000; // For visibility, as in the estimator.
+    } else {
+      c->_currentDerivativeValue = 0;
+    }
+  }
+}
+
 void DESDA::updateM() {
   if(_sgmKPSS < 0) return;
 
@@ -461,6 +963,8 @@ QVector<double> DESDA::getErrorDomain(int dimension) {
 }
 
 QVector<double> DESDA::getWindowedErrorDomain(int dimension) {
+  materializeWindowedSmoothingParameters();
+
   std::vector<std::shared_ptr<cluster>> currentClusters =
       getClustersForWindowedEstimator();
   std::vector<double> attributesValues =
@@ -501,12 +1005,75 @@ std::vector<double> DESDA::calculateH(const std::vector<clusterPtr> &clusters) {
     pluginSmoothingParameterCounter counter(&samples, _pluginRank);
     smoothingParameters.push_back(counter.countSmoothingParameterValue()
                                   * _smoothingParameterEnhancer);
+    KERDEP_PROFILE_COUNT(ProfiledCounter::kBandwidthRecomputations, 1);
+  }
+
+  return smoothingParameters;
+}
+
+/** DESDA::setSmoothingParameterScheduling
+ * @brief Enables (or disables) scheduling of the plug-in smoothing parameters.
+ * When enabled, plug-in is rerun only when running weighted Silverman estimate
+ * drifts by more than tolerance (relative), sgmKPSS is at least the threshold
+ * or maxSamplesBetweenPluginRuns elements came since the last run. In other
+ * steps the last plug-in values are scaled by the ratio of Silverman estimates.
+ * Disabled by default, so that h is exactly the plug-in one.
+ */
+void DESDA::setSmoothingParameterScheduling(bool isEnabled, double tolerance, double sgmKPSSThreshold,
+                                            int maxSamplesBetweenPluginRuns) {
+  _smoothingParameterScheduler.reset();
+  _windowedSmoothingParameterScheduler.reset();
+
+  if(!isEnabled) return;
+
+  _smoothingParameterScheduler.reset(
+    new smoothingParameterScheduler(tolerance, sgmKPSSThreshold, maxSamplesBetweenPluginRuns));
+  _windowedSmoothingParameterScheduler.reset(
+    new smoothingParameterScheduler(tolerance, sgmKPSSThreshold, maxSamplesBetweenPluginRuns));
+}
+
+/** DESDA::getSmoothingParameterPluginRunsNumber
+ * @brief Returns number of plug-in runs of the estimator and windowed smoothing
+ * parameters since scheduling was enabled. Use with getSmoothingParameterApproximationsNumber
+ * to see how often the plug-in was actually needed.
+ */
+int DESDA::getSmoothingParameterPluginRunsNumber() {
+  if(!_smoothingParameterScheduler) return 0;
+
+  return _smoothingParameterScheduler->getPluginRunsNumber()
+         + _windowedSmoothingParameterScheduler->getPluginRunsNumber();
+}
+
+int DESDA::getSmoothingParameterApproximationsNumber() {
+  if(!_smoothingParameterScheduler) return 0;
+
+  return _smoothingParameterScheduler->getApproximationsNumber()
+         + _windowedSmoothingParameterScheduler->getApproximationsNumber();
+}
+
+/** DESDA::scheduleH
+ * @brief Returns smoothing parameters for given clusters, running the plug-in
+ * only if the scheduler requires it. Without scheduler it's just calculateH.
+ */
+std::vector<double> DESDA::scheduleH(smoothingParameterScheduler *scheduler,
+                                     const std::vector<clusterPtr> &clusters) {
+  if(scheduler == nullptr) return calculateH(clusters);
+
+  if(clusters.size() == 1 || scheduler->isPluginRunNeeded(_sgmKPSS)) {
+    auto smoothingParameters = calculateH(clusters);
+    scheduler->setPluginSmoothingParameters(smoothingParameters);
+    return smoothingParameters;
   }
 
+  auto smoothingParameters = scheduler->getApproximatedSmoothingParameters();
+  KERDEP_PROFILE_COUNT(ProfiledCounter::kBandwidthApproximations, smoothingParameters.size());
+
   return smoothingParameters;
 }
 
 QVector<double> DESDA::getKernelPrognosisDerivativeValues(const QVector<qreal> *X, int dimension) {
+  materializeWindowedSmoothingParameters();
+
   std::vector<std::shared_ptr<cluster>> currentClusters
       = getClustersForEstimator();
   std::vector<double> prognosisCoefficients = {};
@@ -546,6 +1113,10 @@ QVector<double> DESDA::getKernelPrognosisDerivativeValues(const QVector<qreal> *
 }
 
 std::vector<double> DESDA::getEnhancedKDEValues(const std::vector<std::vector<double>> *X, int dimension) {
+  materializeDerivatives();
+
+  materializeWindowedSmoothingParameters();
+
   auto currentClusters = getClustersForEstimator();
   auto standardWeights = getClustersWeights(currentClusters);
   sigmoidallyEnhanceClustersWeights(&currentClusters);
@@ -618,6 +1189,8 @@ void DESDA::sigmoidallyEnhanceClustersWeights(std::vector<std::shared_ptr<cluste
 }
 
 vector<double> DESDA::getWindowKDEValues(const vector<vector<qreal>> *X, int dimension) {
+  materializeWindowedSmoothingParameters();
+
   vector<double> windowKDEValues = {};
   auto currentClusters = getClustersForWindowedEstimator();
   _estimator->setClusters(currentClusters);
@@ -647,6 +1220,8 @@ vector<double> DESDA::getWindowKDEValues(const vector<vector<qreal>> *X, int dim
 }
 
 std::vector<double> DESDA::getKDEValues(const vector<vector<double>> *X, int dimension) {
+  materializeWindowedSmoothingParameters();
+
   std::vector<double> KDEValues = {};
   auto currentClusters = getClustersForEstimator();
   _estimator->setClusters(currentClusters);
@@ -673,6 +1248,8 @@ std::vector<double> DESDA::getKDEValues(const vector<vector<double>> *X, int dim
 }
 
 std::vector<double> DESDA::getWeightedKDEValues(const vector<vector<double>> *X, int dimension) {
+  materializeWindowedSmoothingParameters();
+
   std::vector<double> weightedKDEValues = {};
   auto currentClusters = getClustersForEstimator();
   _estimator->setClusters(currentClusters);
@@ -752,6 +1329,8 @@ double DESDA::getStationarityTestValue() {
 }
 
 void DESDA::prepareEstimatorForContourPlotDrawing() {
+  materializeDerivatives();
+
   auto currentClusters = getClustersForEstimator();
   _unmodifiedCWeightsOfClusters = getClustersWeights(*_clusters);
 
@@ -776,6 +1355,8 @@ void DESDA::restoreClustersCWeights() {
  * @return Vector of atypical/rare/uncommon elements in _clusters.
  */
 std::vector<clusterPtr> DESDA::getAtypicalElements() {
+  materializeDerivatives();
+
   auto AKDEValues = getVectorOfAcceleratedKDEValuesOnClusters();
   auto sortedIndicesValues = getSortedAcceleratedKDEValues(AKDEValues);
   recountQuantileEstimatorValue(sortedIndicesValues);
@@ -810,6 +1391,18 @@ std::vector<double> DESDA::getVectorOfAcceleratedKDEValuesOnClusters() {
   std::vector<double> AKDEValues = {};
   auto m = consideredClusters.size();
 
+  if(_kernelMatrixCache) {
+    for(int i = 0; i < m; ++i) {
+      AKDEValues.push_back(getCachedKDEValueOnCluster(consideredClusters[i], consideredClusters, true, {}, i));
+    }
+
+    // Restore weights
+    for(unsigned int i = 0; i < consideredClusters.size(); ++i)
+      consideredClusters[i]->setCWeight(standardWeights[i]);
+
+    return AKDEValues;
+  }
+
   for(auto i = 0; i < m; ++i) {
     auto c = consideredClusters[0];
     consideredClusters.erase(consideredClusters.begin(), consideredClusters.begin() + 1);
@@ -903,6 +1496,10 @@ void DESDA::recountQuantileEstimatorValue(const std::vector<std::pair<int, doubl
 }
 
 std::vector<double> DESDA::getRareElementsEnhancedKDEValues(const std::vector<std::vector<double>> *X, int dimension) {
+  materializeDerivatives();
+
+  materializeWindowedSmoothingParameters();
+
   std::vector<double> enhancedKDEValues = {};
   auto currentClusters = getClustersForEstimator();
   auto standardWeights = getClustersWeights(currentClusters);
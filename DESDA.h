@@ -4,9 +4,12 @@
 #include <QDebug>
 #include <memory>
 #include <map>
+#include <unordered_map>
 
 #include "KDE/kerneldensityestimator.h"
 #include "KDE/weightedSilvermanSmoothingParameterCounter.h"
+#include "KDE/smoothingParameterScheduler.h"
+#include "KDE/clusterKernelMatrixCache.h"
 #include "Distributions/distributions.h"
 #include "Reservoir_sampling/reservoirSamplingAlgorithm.h"
 #include "groupingThread/groupingThread.h"
@@ -25,6 +28,9 @@ class DESDA
           double desiredRarity, double pluginRank=2);
 
     void performStep();
+    int performSteps(int elementsNumber, double latencyBudget = 0);
+    void ingestElement();
+    void refreshEstimator();
     QVector<double> getKernelPrognosisDerivativeValues(const QVector<qreal> *X, int dimension=0);
     std::vector<double> getEnhancedKDEValues(const std::vector<std::vector<double>> *X, int dimension=0);
     std::vector<double> getWeightedKDEValues(const vector<vector<double>> *X, int dimension= 0);
@@ -38,6 +44,15 @@ class DESDA
     cluster getEmECluster();
     double getStationarityTestValue();
 
+    void setSmoothingParameterScheduling(bool isEnabled, double tolerance = 0.05, double sgmKPSSThreshold = 0.5,
+                                         int maxSamplesBetweenPluginRuns = 50);
+    int getSmoothingParameterPluginRunsNumber();
+    int getSmoothingParameterApproximationsNumber();
+    void setIncrementalKDEOnClusters(bool isEnabled, double tolerance = 0.01, int maxRefreshesBetweenFullRecomputes = 100);
+    void setKernelMatrixCaching(bool isEnabled);
+    void setBackgroundGrouping(groupingThread *thread, int stepsBetweenGroupings = 100);
+    unsigned long long getStoredMedoidsEpoch();
+
     // 2D Plot changes
     void prepareEstimatorForContourPlotDrawing();
     std::vector<double> _unmodifiedCWeightsOfClusters = {};
@@ -113,6 +128,14 @@ class DESDA
     int _medoidsNumber = 50;
     int _pluginRank = 2;
 
+    double _lastRefreshDuration = 0; // In ms, used to fit batches in the latency budget.
+
+    // Products of the estimator that are computed only when a query needs them.
+    bool _areWindowedSmoothingParametersDirty = true;
+    bool _areDerivativesDirty = true;
+    void materializeWindowedSmoothingParameters();
+    void materializeDerivatives();
+
     double _weightModifier = 0.0;
     double _smoothingParameterMultiplier = 1.0;
     double _positionalSecondGradeEstimator = 0.0;
@@ -128,6 +151,15 @@ class DESDA
     std::vector<std::shared_ptr<cluster>> *_storedMedoids;
     std::vector<std::shared_ptr<cluster>> _uncommonClusters;
 
+    // Background grouping of clusters into stored medoids, disabled (null) by
+    // default.
+    groupingThread *_groupingThread = nullptr;
+    int _stepsBetweenGroupings = 100;
+    unsigned long long _storedMedoidsEpoch = 0;
+    void updateStoredMedoids();
+    void applyPublishedMedoids();
+    void forgetReplacedClusters(const std::vector<std::shared_ptr<cluster>> &replacedClusters);
+
     // Random deletion
     std::default_random_engine generator;
     std::uniform_real_distribution<double> dist;
@@ -138,6 +170,30 @@ class DESDA
     std::vector<std::shared_ptr<cluster>> getClustersForEstimator();
     std::vector<std::shared_ptr<cluster>> getClustersForWindowedEstimator();
     void countKDEValuesOnClusters();
+
+    // Incremental KDE on clusters, disabled by default.
+    struct kdePartialSums {
+      std::vector<double> x = {};
+      double s0 = 0; // Sum of kernels of window clusters.
+      double s1 = 0; // Sum of kernels of window clusters multiplied by their positions.
+    };
+    bool _isIncrementalKDEOnClustersEnabled = false;
+    double _incrementalKDETolerance = 0.01;
+    int _maxRefreshesBetweenFullKDERecomputes = 100;
+    int _refreshesSinceFullKDERecompute = 0;
+    std::vector<double> _kdePartialSumsSmoothingParameters = {};
+    std::vector<std::shared_ptr<cluster>> _kdePartialSumsWindow = {};
+    std::unordered_map<std::shared_ptr<cluster>, kdePartialSums> _kdePartialSums = {};
+    void countKDEValuesOnClustersIncrementally(const std::vector<std::shared_ptr<cluster>> &consideredClusters);
+    bool shouldRecomputeKDEPartialSums();
+
+    // Kernel values between pairs of clusters, disabled (null) by default.
+    std::unique_ptr<clusterKernelMatrixCache> _kernelMatrixCache;
+    double getCachedKDEValueOnCluster(const std::shared_ptr<cluster> &c,
+                                      const std::vector<std::shared_ptr<cluster>> &clusters,
+                                      bool shouldConsiderWeights, const std::vector<double> &multipliers = {},
+                                      int skippedIndex = -1);
+    void countCachedDerivativeValuesOnClusters();
     void updatePrognosisParameters();
     void countDerivativeValuesOnClusters();
     void updateM();
@@ -154,6 +210,11 @@ class DESDA
 
     std::vector<double> calculateH(const std::vector<clusterPtr> &clusters);
 
+    // Plug-in runs scheduling, disabled (null) by default.
+    std::unique_ptr<smoothingParameterScheduler> _smoothingParameterScheduler;
+    std::unique_ptr<smoothingParameterScheduler> _windowedSmoothingParameterScheduler;
+    std::vector<double> scheduleH(smoothingParameterScheduler *scheduler, const std::vector<clusterPtr> &clusters);
+
     void enhanceWeightsOfUncommonElements();
     std::vector<double> getVectorOfAcceleratedKDEValuesOnClusters();
     std::vector<std::pair<int, double> > getSortedAcceleratedKDEValues(const std::vector<double> &AKDEValues);
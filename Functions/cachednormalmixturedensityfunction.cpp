@@ -0,0 +1,145 @@
+#include "cachednormalmixturedensityfunction.h"
+
+#include "QtMath"
+#include <QDebug>
+
+#include "../Libraries/matrixoperationslibrary.h"
+
+cachedNormalMixtureDensityFunction::cachedNormalMixtureDensityFunction(vector<double> *contributions,
+                                                                       vector<std::shared_ptr<vector<double>>> *means,
+                                                                       vector<std::shared_ptr<vector<double>>> *stDevs,
+                                                                       double correlationCoefficient)
+{
+    componentsNumber = contributions->size();
+    dimension = componentsNumber > 0 ? means->at(0)->size() : 0;
+
+    choleskyFactors.assign(componentsNumber * dimension * dimension, 0);
+    scalingFactors.assign(componentsNumber, 0);
+    centeredPoint.assign(dimension, 0);
+
+    for(size_t c = 0; c < componentsNumber; ++c)
+    {
+        matrix covarianceMatrix;
+        fillCovarianceMatrix(correlationCoefficient, stDevs->at(c).get(), &covarianceMatrix);
+
+        // Cholesky-Banachiewicz decomposition, Sigma = L * L^T.
+        double *L = &choleskyFactors[c * dimension * dimension];
+        double determinantSqrt = 1;
+
+        for(size_t i = 0; i < dimension; ++i)
+        {
+            for(size_t j = 0; j <= i; ++j)
+            {
+                double sum = covarianceMatrix[i]->at(j);
+
+                for(size_t k = 0; k < j; ++k)
+                    sum -= L[i * dimension + k] * L[j * dimension + k];
+
+                if(i == j)
+                {
+                    if(sum <= 0)
+                    {
+                        qDebug() << "Covariance matrix is not positive definite.";
+                        sum = 0;
+                    }
+
+                    L[i * dimension + i] = qSqrt(sum);
+                    determinantSqrt *= L[i * dimension + i];
+                }
+                else
+                {
+                    L[i * dimension + j] = L[j * dimension + j] == 0 ? 0 : sum / L[j * dimension + j];
+                }
+            }
+        }
+
+        if(determinantSqrt == 0)
+        {
+            qDebug() << "Determinant is 0.";
+            continue;
+        }
+
+        scalingFactors[c] = contributions->at(c) / 100.0
+                            / qPow(2 * M_PI, dimension / 2.0)
+                            / determinantSqrt;
+    }
+
+    setMeans(*means);
+}
+
+void cachedNormalMixtureDensityFunction::setMeans(const vector<std::shared_ptr<vector<double>>> &newMeans)
+{
+    means.resize(componentsNumber * dimension);
+
+    for(size_t c = 0; c < componentsNumber; ++c)
+    {
+        for(size_t i = 0; i < dimension; ++i)
+            means[c * dimension + i] = newMeans[c]->at(i);
+    }
+}
+
+double cachedNormalMixtureDensityFunction::getValue(point *arguments)
+{
+    return computeValue(arguments->data(), centeredPoint.data());
+}
+
+vector<double> cachedNormalMixtureDensityFunction::getValues(const vector<point> &domain) const
+{
+    vector<double> values(domain.size(), 0);
+    vector<double> buffer(dimension, 0);
+
+    if(dimension == 1)
+    {
+        // Most experiments are 1D, where Cholesky factor is just the standard
+        // deviation, so skip the generic triangular solve.
+        for(size_t c = 0; c < componentsNumber; ++c)
+        {
+            double inverseStDev = 1.0 / choleskyFactors[c];
+            double mean = means[c];
+            double scale = scalingFactors[c];
+
+            for(size_t i = 0; i < domain.size(); ++i)
+            {
+                double z = (domain[i][0] - mean) * inverseStDev;
+                values[i] += scale * exp(-0.5 * z * z);
+            }
+        }
+
+        return values;
+    }
+
+    for(size_t i = 0; i < domain.size(); ++i)
+        values[i] = computeValue(domain[i].data(), buffer.data());
+
+    return values;
+}
+
+double cachedNormalMixtureDensityFunction::computeValue(const double *arguments, double *buffer) const
+{
+    double result = 0;
+
+    for(size_t c = 0; c < componentsNumber; ++c)
+    {
+        if(scalingFactors[c] == 0) continue;
+
+        const double *L = &choleskyFactors[c * dimension * dimension];
+        const double *mean = &means[c * dimension];
+        double squaredMahalanobisDistance = 0;
+
+        // Forward substitution, solving L * y = x - mean.
+        for(size_t i = 0; i < dimension; ++i)
+        {
+            double value = arguments[i] - mean[i];
+
+            for(size_t k = 0; k < i; ++k)
+                value -= L[i * dimension + k] * buffer[k];
+
+            buffer[i] = value / L[i * dimension + i];
+            squaredMahalanobisDistance += buffer[i] * buffer[i];
+        }
+
+        result += scalingFactors[c] * exp(-0.5 * squaredMahalanobisDistance);
+    }
+
+    return result;
+}
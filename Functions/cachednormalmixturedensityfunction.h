@@ -0,0 +1,42 @@
+#ifndef CACHEDNORMALMIXTUREDENSITYFUNCTION_H
+#define CACHEDNORMALMIXTUREDENSITYFUNCTION_H
+
+#include <memory>
+
+#include "function.h"
+
+/** class cachedNormalMixtureDensityFunction
+ * @brief Mixture of multivariate normal densities, that precomputes Cholesky
+ * factors and normalizing constants once. Only means are expected to change
+ * during experiments, and they can be updated in place with setMeans.
+ */
+class cachedNormalMixtureDensityFunction : public function
+{
+    public:
+        cachedNormalMixtureDensityFunction(vector<double> *contributions,
+                                           vector<std::shared_ptr<vector<double>>> *means,
+                                           vector<std::shared_ptr<vector<double>>> *stDevs,
+                                           double correlationCoefficient = 0);
+
+        double getValue(point *arguments) override;
+        vector<double> getValues(const vector<point> &domain) const;
+        void setMeans(const vector<std::shared_ptr<vector<double>>> &newMeans);
+
+    private:
+        size_t dimension = 0;
+        size_t componentsNumber = 0;
+
+        // Flattened, row-major storage. Component c occupies
+        // [c * dimension, (c + 1) * dimension) in means and
+        // [c * dimension^2, (c + 1) * dimension^2) in choleskyFactors.
+        vector<double> means;
+        vector<double> choleskyFactors;
+        // Contribution / ((2 pi)^(d/2) sqrt(det(Sigma))) for each component.
+        vector<double> scalingFactors;
+
+        vector<double> centeredPoint;
+
+        double computeValue(const double *arguments, double *buffer) const;
+};
+
+#endif // CACHEDNORMALMIXTUREDENSITYFUNCTION_H
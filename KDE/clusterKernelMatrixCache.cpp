@@ -0,0 +1,123 @@
+#include "clusterKernelMatrixCache.h"
+
+#include <algorithm>
+
+clusterKernelMatrixCache::clusterKernelMatrixCache(const kernelDensityEstimator &estimator, size_t capacity)
+  : _estimator(estimator)
+{
+  resize(std::max<size_t>(capacity, 1));
+}
+
+/** clusterKernelMatrixCache::setSmoothingParameters
+ * @brief Sets smoothing parameters of the kernels. If they differ from the
+ * current ones, all cached values are invalidated.
+ */
+void clusterKernelMatrixCache::setSmoothingParameters(const std::vector<double> &smoothingParameters)
+{
+  if(smoothingParameters == _smoothingParameters) return;
+
+  _smoothingParameters = smoothingParameters;
+  _estimator.setSmoothingParameters(_smoothingParameters);
+
+  if(++_epoch == 0) {
+    // Epochs wrapped around, so old values could look valid.
+    std::fill(_epochs.begin(), _epochs.end(), 0);
+    _epoch = 1;
+  }
+}
+
+/** clusterKernelMatrixCache::removeCluster
+ * @brief Frees the slot of the cluster, e.g. when it leaves the reservoir.
+ */
+void clusterKernelMatrixCache::removeCluster(const std::shared_ptr<cluster> &c)
+{
+  auto entry = _entries.find(c);
+
+  if(entry == _entries.end()) return;
+
+  _slotsOwners[entry->second.slot] = nullptr;
+  _entries.erase(entry);
+}
+
+double clusterKernelMatrixCache::getKernelValue(const std::shared_ptr<cluster> &point,
+                                                const std::shared_ptr<cluster> &center)
+{
+  auto &pointEntry = getEntry(point);
+  auto &centerEntry = getEntry(center);
+  size_t index = pointEntry.slot * _capacity + centerEntry.slot;
+
+  if(_epochs[index] == _epoch) {
+    ++_hitsNumber;
+    return _values[index];
+  }
+
+  ++_missesNumber;
+  _values[index] = _estimator.getProductKernelAddendFromSample(&centerEntry.x, &pointEntry.x);
+  _epochs[index] = _epoch;
+
+  return _values[index];
+}
+
+unsigned long long clusterKernelMatrixCache::getHitsNumber()
+{
+  return _hitsNumber;
+}
+
+unsigned long long clusterKernelMatrixCache::getMissesNumber()
+{
+  return _missesNumber;
+}
+
+/** clusterKernelMatrixCache::getEntry
+ * @brief Returns entry of the cluster, giving it the next free slot of the ring
+ * (and clearing its row and column) if it's the first use of the cluster.
+ */
+clusterKernelMatrixCache::clusterEntry &clusterKernelMatrixCache::getEntry(const std::shared_ptr<cluster> &c)
+{
+  auto entry = _entries.find(c);
+
+  if(entry != _entries.end()) return entry->second;
+
+  if(_slotsOwners[_nextSlot] != nullptr) {
+    // Ring is full. Slots in between might be free, but it would soon be full
+    // again anyway.
+    resize(2 * _capacity);
+  }
+
+  size_t slot = _nextSlot;
+  _nextSlot = (_nextSlot + 1) % _capacity;
+  _slotsOwners[slot] = c.get();
+
+  for(size_t i = 0; i < _capacity; ++i) {
+    _epochs[slot * _capacity + i] = 0;
+    _epochs[i * _capacity + slot] = 0;
+  }
+
+  auto &newEntry = _entries[c];
+  newEntry.slot = slot;
+
+  for(auto attribute: *c->getRepresentative()->attirbutesOrder)
+    newEntry.x.push_back(std::stod(c->getRepresentative()->attributesValues[attribute]));
+
+  return newEntry;
+}
+
+/** clusterKernelMatrixCache::resize
+ * @brief Resizes the ring, giving current clusters consecutive slots from the
+ * beginning. Cached values are dropped.
+ */
+void clusterKernelMatrixCache::resize(size_t capacity)
+{
+  _capacity = capacity;
+  _values.assign(_capacity * _capacity, 0);
+  _epochs.assign(_capacity * _capacity, 0);
+  _slotsOwners.assign(_capacity, nullptr);
+  _nextSlot = 0;
+
+  for(auto &entry : _entries) {
+    entry.second.slot = _nextSlot;
+    _slotsOwners[_nextSlot++] = entry.first.get();
+  }
+
+  _nextSlot %= _capacity;
+}
@@ -0,0 +1,57 @@
+#ifndef CLUSTERKERNELMATRIXCACHE_H
+#define CLUSTERKERNELMATRIXCACHE_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "kerneldensityestimator.h"
+
+/** Cache of kernel values between pairs of clusters, for given smoothing
+ * parameters. Clusters get slots of a ring, in order of their first use, so
+ * that as the stream goes by, the values of current clusters form a band of the
+ * ring-indexed matrix. Slot of removed cluster (and its row and column) is
+ * reused by later ones. If the ring is full, it's doubled and values are
+ * recomputed on demand. Change of smoothing parameters invalidates all the
+ * values at once.
+ *
+ * Values are computed lazily with the kernels of the estimator given on
+ * construction, so they're only valid for estimators with the same kernels.
+ */
+class clusterKernelMatrixCache
+{
+  public:
+    clusterKernelMatrixCache(const kernelDensityEstimator &estimator, size_t capacity = 256);
+
+    void setSmoothingParameters(const std::vector<double> &smoothingParameters);
+    void removeCluster(const std::shared_ptr<cluster> &c);
+    double getKernelValue(const std::shared_ptr<cluster> &point, const std::shared_ptr<cluster> &center);
+
+    unsigned long long getHitsNumber();
+    unsigned long long getMissesNumber();
+
+  protected:
+    struct clusterEntry {
+      size_t slot = 0;
+      std::vector<double> x = {};
+    };
+
+    kernelDensityEstimator _estimator;
+    std::vector<double> _smoothingParameters = {};
+
+    size_t _capacity = 0;
+    size_t _nextSlot = 0;
+    unsigned int _epoch = 1;
+    std::vector<double> _values = {};
+    std::vector<unsigned int> _epochs = {}; // Value is valid if its epoch is current.
+    std::vector<cluster*> _slotsOwners = {};
+    std::unordered_map<std::shared_ptr<cluster>, clusterEntry> _entries = {};
+
+    unsigned long long _hitsNumber = 0;
+    unsigned long long _missesNumber = 0;
+
+    clusterEntry &getEntry(const std::shared_ptr<cluster> &c);
+    void resize(size_t capacity);
+};
+
+#endif // CLUSTERKERNELMATRIXCACHE_H
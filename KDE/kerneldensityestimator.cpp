@@ -4,6 +4,8 @@
 
 #include <QDebug>
 
+#include "../Benchmarking/stepProfiler.h"
+
 kernelDensityEstimator::kernelDensityEstimator(
     vector<std::shared_ptr<vector<double>>>* samples,
     vector<double>* smoothingParameters,
@@ -182,6 +184,7 @@ double kernelDensityEstimator::getProductKernelAddendFromSample(vector<double> *
   bool hasRestriction;
 
   std::unique_ptr<vector<double>> tempValueHolder(new vector<double>());
+  KERDEP_PROFILE_COUNT(ProfiledCounter::kKernelEvaluations, kernels.size());
 
   for(size_t i = 0; i < kernels.size(); ++i)
   {
@@ -224,6 +227,7 @@ double kernelDensityEstimator::getProductKernelAddendFromClusterIndex(int index,
   vector<double> *sample = &s;
 
   extractSampleFromCluster(clusters[index], sample);
+  KERDEP_PROFILE_COUNT(ProfiledCounter::kKernelEvaluations, kernels.size());
 
   for(size_t i = 0; i < kernels.size(); ++i)
   {
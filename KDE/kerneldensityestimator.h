@@ -26,6 +26,7 @@ class kernelDensityEstimator : public function {
     bool _shouldConsiderWeights = true;
     int getDimension();
     void updateSPModifyingParameters();
+    double getProductKernelAddendFromSample(vector<double> *sample, vector<double> *x);
     // DEBUG ONLY
     bool _printClusters = false;
     //
@@ -45,7 +46,6 @@ class kernelDensityEstimator : public function {
     double getProductKernelValue(vector<double> *x);
     double getProductValuesFromClusters(vector<double> *x);
     int extractSampleFromCluster(std::shared_ptr<cluster> c, vector<double> *smpl);
-    double getProductKernelAddendFromSample(vector<double> *sample, vector<double> *x);
     double getProductKernelAddendFromClusterIndex(int i, vector<double> *x);
     double getProductValuesFromSamples(vector<double> *x);
     void fillKernelsList(vector<int> *kernelsIDs);
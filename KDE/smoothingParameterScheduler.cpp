@@ -0,0 +1,100 @@
+#include "smoothingParameterScheduler.h"
+
+#include <cmath>
+
+smoothingParameterScheduler::smoothingParameterScheduler(double tolerance, double sgmKPSSThreshold,
+                                                         int maxSamplesBetweenPluginRuns)
+  : _tolerance(tolerance), _sgmKPSSThreshold(sgmKPSSThreshold),
+    _maxSamplesBetweenPluginRuns(maxSamplesBetweenPluginRuns)
+{}
+
+/** smoothingParameterScheduler::addSample
+ * @brief Updates running Silverman estimates with the new sample, in O(1) per
+ * dimension.
+ * @param values - Values of the sample, one per dimension.
+ * @param weightModifier - Factor by which weights of previous samples are
+ * multiplied, e.g. deactualization parameter of the clusters.
+ */
+void smoothingParameterScheduler::addSample(const std::vector<double> &values, double weightModifier)
+{
+  while(_silvermanCounters.size() < values.size()) {
+    // Counter takes ownership of the (unused) samples and weights.
+    _silvermanCounters.emplace_back(
+      new weightedSilvermanSmoothingParameterCounter(new QVector<qreal>(), new QVector<double>()));
+  }
+
+  for(size_t i = 0; i < values.size(); ++i) {
+    _silvermanCounters[i]->updateSmoothingParameterValue(weightModifier, values[i]);
+  }
+
+  ++_samplesSinceLastPluginRun;
+}
+
+bool smoothingParameterScheduler::isPluginRunNeeded(double sgmKPSS)
+{
+  if(_pluginSmoothingParameters.empty()) return true;
+  if(_pluginSmoothingParameters.size() != _silvermanCounters.size()) return true;
+  if(_silvermanSmoothingParametersAtPluginRun.size() != _silvermanCounters.size()) return true;
+  if(sgmKPSS >= _sgmKPSSThreshold) return true;
+  if(_samplesSinceLastPluginRun >= _maxSamplesBetweenPluginRuns) return true;
+
+  for(size_t i = 0; i < _silvermanCounters.size(); ++i) {
+    double ratio = getSilvermanRatio(i);
+    if(!std::isfinite(ratio) || std::fabs(ratio - 1.0) > _tolerance) return true;
+  }
+
+  return false;
+}
+
+/** smoothingParameterScheduler::setPluginSmoothingParameters
+ * @brief Stores the result of the plug-in run, along with current Silverman
+ * estimates, as a base of the following approximations.
+ */
+void smoothingParameterScheduler::setPluginSmoothingParameters(const std::vector<double> &smoothingParameters)
+{
+  _pluginSmoothingParameters = smoothingParameters;
+  _silvermanSmoothingParametersAtPluginRun.clear();
+
+  for(auto &counter : _silvermanCounters) {
+    _silvermanSmoothingParametersAtPluginRun.push_back(counter->getSmoothingParameterValue());
+  }
+
+  _samplesSinceLastPluginRun = 0;
+  ++_pluginRunsNumber;
+}
+
+/** smoothingParameterScheduler::getApproximatedSmoothingParameters
+ * @brief Returns last plug-in smoothing parameters scaled by the ratio of current
+ * and then Silverman estimates. Should only be used if plug-in run isn't needed.
+ */
+std::vector<double> smoothingParameterScheduler::getApproximatedSmoothingParameters()
+{
+  std::vector<double> smoothingParameters = _pluginSmoothingParameters;
+
+  for(size_t i = 0; i < smoothingParameters.size(); ++i) {
+    smoothingParameters[i] *= getSilvermanRatio(i);
+  }
+
+  ++_approximationsNumber;
+
+  return smoothingParameters;
+}
+
+int smoothingParameterScheduler::getPluginRunsNumber()
+{
+  return _pluginRunsNumber;
+}
+
+int smoothingParameterScheduler::getApproximationsNumber()
+{
+  return _approximationsNumber;
+}
+
+double smoothingParameterScheduler::getSilvermanRatio(size_t dimension)
+{
+  double silvermanAtPluginRun = _silvermanSmoothingParametersAtPluginRun[dimension];
+
+  if(silvermanAtPluginRun <= 0) return NAN;
+
+  return _silvermanCounters[dimension]->getSmoothingParameterValue() / silvermanAtPluginRun;
+}
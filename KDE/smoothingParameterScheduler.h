@@ -0,0 +1,47 @@
+#ifndef SMOOTHINGPARAMETERSCHEDULER_H
+#define SMOOTHINGPARAMETERSCHEDULER_H
+
+#include <memory>
+#include <vector>
+
+#include "weightedSilvermanSmoothingParameterCounter.h"
+
+/** Decides when plug-in smoothing parameters have to be recomputed. Between the
+ * plug-in runs, they're approximated by scaling the last plug-in values with the
+ * ratio of running weighted Silverman estimates, which are updated in O(1) per
+ * new sample. Plug-in is rerun when any of the Silverman estimates drifted from
+ * its value at the last plug-in run by more than the tolerance, when sgmKPSS is
+ * at least the threshold (h changes quickly then) or when given number of
+ * samples came since the last plug-in run.
+ */
+class smoothingParameterScheduler
+{
+  public:
+    smoothingParameterScheduler(double tolerance = 0.05, double sgmKPSSThreshold = 0.5,
+                                int maxSamplesBetweenPluginRuns = 50);
+
+    void addSample(const std::vector<double> &values, double weightModifier);
+    bool isPluginRunNeeded(double sgmKPSS);
+    void setPluginSmoothingParameters(const std::vector<double> &smoothingParameters);
+    std::vector<double> getApproximatedSmoothingParameters();
+
+    int getPluginRunsNumber();
+    int getApproximationsNumber();
+
+  protected:
+    double _tolerance = 0.05;
+    double _sgmKPSSThreshold = 0.5;
+    int _maxSamplesBetweenPluginRuns = 50;
+
+    std::vector<std::unique_ptr<weightedSilvermanSmoothingParameterCounter>> _silvermanCounters = {};
+    std::vector<double> _pluginSmoothingParameters = {};
+    std::vector<double> _silvermanSmoothingParametersAtPluginRun = {};
+    int _samplesSinceLastPluginRun = 0;
+
+    int _pluginRunsNumber = 0;
+    int _approximationsNumber = 0;
+
+    double getSilvermanRatio(size_t dimension);
+};
+
+#endif // SMOOTHINGPARAMETERSCHEDULER_H
@@ -15,6 +15,11 @@ CONFIG      +=  qwt
 
 QMAKE_CXXFLAGS += -std=c++17
 
+# Per-phase timers and counters of DESDA steps, enabled with CONFIG+=profiling.
+profiling {
+    DEFINES += KERDEP_PROFILING
+}
+
 
 if(exists(k:/Libs/)){
     INCLUDEPATH += k:/Libs/Qwt-6.1.5/include/
@@ -51,6 +56,7 @@ INCLUDEPATH += $$PWD/SOMKE/src/
 
 SOURCES     +=  main.cpp\
                 Benchmarking/errorsCalculator.cpp \
+                Benchmarking/stepProfiler.cpp \
                 ClusterKernelWrappers/enhancedClusterKernelAlgorithm.cpp \
                 ClusterKernelWrappers/epanecznikowKernelRealValuedFunction.cpp \
                 ClusterKernelWrappers/univariateStreamElement.cpp \
@@ -61,6 +67,7 @@ SOURCES     +=  main.cpp\
                 Compressed_Cumulative_WDE_Over_Stream/src/CompressedCumulativeWaveletDensityEstimator.cpp \
                 Compressed_Cumulative_WDE_Over_Stream/src/TranslatedDilatedScalingFunction.cpp \
                 Compressed_Cumulative_WDE_Over_Stream/src/TranslatedDilatedWaveletFunction.cpp \
+                Compressed_Cumulative_WDE_Wrappers/TabulatedWaveletFunction.cpp \
                 Compressed_Cumulative_WDE_Wrappers/LinearWDE.cpp \
                 Compressed_Cumulative_WDE_Wrappers/ThresholdingStrategies/hardThresholdingStrategy.cpp \
                 Compressed_Cumulative_WDE_Wrappers/ThresholdingStrategies/softThresholdingStrategy.cpp \
@@ -77,10 +84,17 @@ SOURCES     +=  main.cpp\
                 SOMKEWrappers/somkeNormalKernel.cpp \
                 UI/QwtContourPlotUI.cpp \
                 UI/plot.cpp \
+                UI/marchingSquaresContourExtractor.cpp \
+                UI/frameExportPipeline.cpp \
+                UI/curveDump.cpp \
+                UI/plotCurvesModel.cpp \
+                UI/estimatorSnapshotBuffer.cpp \
+                UI/estimatorWorker.cpp \
                 UI/plotLabelDoubleDataPreparator.cpp \
                 UI/plotLabelIntDataPreparator.cpp \
                 mainwindow.cpp \
                 QCustomPlot/qcustomplot.cpp \
+                KDE/clusterKernelMatrixCache.cpp \
                 KDE/kerneldensityestimator.cpp \
                 Distributions/normaldistribution.cpp \
                 Functions/Kernels/dullkernel.cpp \
@@ -89,7 +103,9 @@ SOURCES     +=  main.cpp\
                 Functions/Kernels/epanecznikowkernel.cpp \
                 KDE/pluginsmoothingparametercounter.cpp \
                 Functions/multivariatenormalprobabilitydensityfunction.cpp \
+                Functions/cachednormalmixturedensityfunction.cpp \
                 Libraries/matrixoperationslibrary.cpp \
+                Libraries/threadPool.cpp \
                 Functions/complexfunction.cpp \
                 Distributions/complexdistribution.cpp \
                 Reservoir_sampling/biasedReservoirSamplingAlgorithm.cpp \
@@ -98,6 +114,7 @@ SOURCES     +=  main.cpp\
                 Reservoir_sampling/progressivedistributiondatareader.cpp \
                 Reservoir_sampling/distributionDataSample.cpp \
                 KDE/weightedSilvermanSmoothingParameterCounter.cpp \
+                KDE/smoothingParameterScheduler.cpp \
                 groupingThread/groupingThread.cpp \
                 groupingThread/kMedoidsAlgorithm/attributesDistanceMeasures/categorical/smdCategoricalAttributesDistanceMeasure.cpp \
                 groupingThread/kMedoidsAlgorithm/attributesDistanceMeasures/numerical/gowersNumericalAttributesDistanceMeasure.cpp \
@@ -113,12 +130,15 @@ SOURCES     +=  main.cpp\
                 groupingThread/kMedoidsAlgorithm/numericalAttributeData.cpp \
                 groupingThread/medoidStoringAlgorithm/medoidStoringAlgorithm.cpp \
                 groupingThread/kMeansAlgorithm.cpp \
+                groupingThread/clusterPairDistanceCache.cpp \
+                groupingThread/numericalKMeans.cpp \
                 DESDA.cpp \
                 StationarityTests/kpssstationaritytest.cpp \
                 UI/plotLabel.cpp
 
 HEADERS     +=  mainwindow.h \
                 Benchmarking/errorsCalculator.h \
+                Benchmarking/stepProfiler.h \
                 ClusterKernelWrappers/enhancedClusterKernelAlgorithm.h \
                 ClusterKernelWrappers/epanecznikowKernelRealValuedFunction.h \
                 ClusterKernelWrappers/univariateStreamElement.h \
@@ -133,6 +153,7 @@ HEADERS     +=  mainwindow.h \
                 Compressed_Cumulative_WDE_Over_Stream/include/Compressed_Cumulative_WDE_Over_Stream/TranslatedDilatedScalingFunction.h \
                 Compressed_Cumulative_WDE_Over_Stream/include/Compressed_Cumulative_WDE_Over_Stream/TranslatedDilatedWaveletFunction.h \
                 Compressed_Cumulative_WDE_Over_Stream/include/Compressed_Cumulative_WDE_Over_Stream/WaveletDensityEstimator.h \
+                Compressed_Cumulative_WDE_Wrappers/TabulatedWaveletFunction.h \
                 Compressed_Cumulative_WDE_Wrappers/LinearWDE.h \
                 Compressed_Cumulative_WDE_Wrappers/ThresholdingStrategies/ThresholdingStrategyInterface.h \
                 Compressed_Cumulative_WDE_Wrappers/ThresholdingStrategies/hardThresholdingStrategy.h \
@@ -145,6 +166,7 @@ HEADERS     +=  mainwindow.h \
                 DESDAReservoir.h \
                 QCustomPlot/qcustomplot.h \
                 Functions/function.h \
+                KDE/clusterKernelMatrixCache.h \
                 KDE/kerneldensityestimator.h \
                 Distributions/distributions.h \
                 Distributions/distribution.h \
@@ -157,7 +179,9 @@ HEADERS     +=  mainwindow.h \
                 Functions/Kernels/kernels.h \
                 KDE/pluginsmoothingparametercounter.h \
                 Functions/multivariatenormalprobabilitydensityfunction.h \
+                Functions/cachednormalmixturedensityfunction.h \
                 Libraries/matrixoperationslibrary.h \
+                Libraries/threadPool.h \
                 Functions/complexfunction.h \
                 Distributions/complexdistribution.h \
                 Reservoir_sampling/biasedReservoirSamplingAlgorithm.h \
@@ -170,6 +194,7 @@ HEADERS     +=  mainwindow.h \
                 Reservoir_sampling/distributionDataSample.h \
                 KDE/smoothingParameterCounter.h \
                 KDE/weightedSilvermanSmoothingParameterCounter.h \
+                KDE/smoothingParameterScheduler.h \
                 Reservoir_sampling/sample.h \
                 Reservoir_sampling/textDataReader.h \
                 SOMKE/include/SOMKE/Kernel.h \
@@ -183,6 +208,12 @@ HEADERS     +=  mainwindow.h \
                 UI/QwtContourPlotUI.h \
                 UI/i_plotLabelDataPreparator.h \
                 UI/plot.h \
+                UI/marchingSquaresContourExtractor.h \
+                UI/frameExportPipeline.h \
+                UI/curveDump.h \
+                UI/plotCurvesModel.h \
+                UI/estimatorSnapshotBuffer.h \
+                UI/estimatorWorker.h \
                 UI/plotLabelDoubleDataPreparator.h \
                 UI/plotLabelIntDataPreparator.h \
                 groupingThread/groupingThread.h \
@@ -214,6 +245,8 @@ HEADERS     +=  mainwindow.h \
                 groupingThread/kMedoidsAlgorithm/objectsDistanceMeasure.h \
                 groupingThread/medoidStoringAlgorithm/medoidStoringAlgorithm.h \
                 groupingThread/kMeansAlgorithm.h \
+                groupingThread/clusterPairDistanceCache.h \
+                groupingThread/numericalKMeans.h \
                 DESDA.h \
                 StationarityTests/kpssstationaritytest.h \
                 StationarityTests/i_stationaritytest.h \
@@ -0,0 +1,94 @@
+#-------------------------------------------------
+#
+# Headless microbenchmarks of the numerical core.
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET      =   KerDEPBenchmarks
+TEMPLATE    =   app
+CONFIG      +=  console
+CONFIG      -=  app_bundle
+
+QMAKE_CXXFLAGS += -std=c++17
+
+profiling {
+    DEFINES += KERDEP_PROFILING
+}
+
+if(exists(k:/Libs/)){
+    INCLUDEPATH += k:/Libs/boost_1_75_0/
+    INCLUDEPATH += k:/Libs/knnl/include/
+}
+
+if(exists(y:/Code/)){
+    INCLUDEPATH += y:/boost_1_75_0/
+    INCLUDEPATH += y:/knnl/include/
+}
+
+INCLUDEPATH += $$PWD/
+
+INCLUDEPATH += $$PWD/Compressed_Cumulative_WDE_Over_Stream/include/Compressed_Cumulative_WDE_Over_Stream
+INCLUDEPATH += $$PWD/Compressed_Cumulative_WDE_Over_Stream/src
+
+INCLUDEPATH += $$PWD/Compressed_Cumulative_WDE_Wrappers/
+
+
+SOURCES     +=  Benchmarking/microbenchmarks.cpp \
+                Benchmarking/benchmarkHarness.cpp \
+                Benchmarking/benchmarkStream.cpp \
+                Benchmarking/errorsCalculator.cpp \
+                Benchmarking/stepProfiler.cpp \
+                DESDA.cpp \
+                KDE/clusterKernelMatrixCache.cpp \
+                KDE/kerneldensityestimator.cpp \
+                KDE/pluginsmoothingparametercounter.cpp \
+                KDE/weightedSilvermanSmoothingParameterCounter.cpp \
+                KDE/smoothingParameterScheduler.cpp \
+                Functions/Kernels/dullkernel.cpp \
+                Functions/Kernels/normalkernel.cpp \
+                Functions/Kernels/trianglekernel.cpp \
+                Functions/Kernels/epanecznikowkernel.cpp \
+                Functions/multivariatenormalprobabilitydensityfunction.cpp \
+                Functions/cachednormalmixturedensityfunction.cpp \
+                Functions/complexfunction.cpp \
+                Libraries/matrixoperationslibrary.cpp \
+                Libraries/threadPool.cpp \
+                Distributions/normaldistribution.cpp \
+                Distributions/complexdistribution.cpp \
+                Reservoir_sampling/distributiondataparser.cpp \
+                Reservoir_sampling/basicReservoirSamplingAlgorithm.cpp \
+                Reservoir_sampling/progressivedistributiondatareader.cpp \
+                Reservoir_sampling/distributionDataSample.cpp \
+                StationarityTests/kpssstationaritytest.cpp \
+                groupingThread/groupingThread.cpp \
+                groupingThread/kMedoidsAlgorithm/attributesDistanceMeasures/categorical/smdCategoricalAttributesDistanceMeasure.cpp \
+                groupingThread/kMedoidsAlgorithm/attributesDistanceMeasures/numerical/gowersNumericalAttributesDistanceMeasure.cpp \
+                groupingThread/kMedoidsAlgorithm/attributesDistanceMeasures/numerical/smdNumericalAttributesDistanceMeasure.cpp \
+                groupingThread/kMedoidsAlgorithm/clusterDistanceMeasures/averageLinkClusterDistanceMeasure.cpp \
+                groupingThread/kMedoidsAlgorithm/clusterDistanceMeasures/centroidLinkClusterDistanceMeasure.cpp \
+                groupingThread/kMedoidsAlgorithm/clusterDistanceMeasures/completeLinkClusterDistanceMeasure.cpp \
+                groupingThread/kMedoidsAlgorithm/clusterDistanceMeasures/singleLinkClusterDistanceMeasure.cpp \
+                groupingThread/kMedoidsAlgorithm/groupingAlgorithm/cluster.cpp \
+                groupingThread/kMedoidsAlgorithm/categoricalAttributeData.cpp \
+                groupingThread/kMedoidsAlgorithm/customObjectsDistanceMeasure.cpp \
+                groupingThread/kMedoidsAlgorithm/kMedoidsAlgorithm.cpp \
+                groupingThread/kMedoidsAlgorithm/numericalAttributeData.cpp \
+                groupingThread/medoidStoringAlgorithm/medoidStoringAlgorithm.cpp \
+                groupingThread/kMeansAlgorithm.cpp \
+                groupingThread/clusterPairDistanceCache.cpp \
+                groupingThread/numericalKMeans.cpp \
+                Compressed_Cumulative_WDE_Over_Stream/src/TranslatedDilatedScalingFunction.cpp \
+                Compressed_Cumulative_WDE_Over_Stream/src/TranslatedDilatedWaveletFunction.cpp \
+                Compressed_Cumulative_WDE_Wrappers/TabulatedWaveletFunction.cpp \
+                Compressed_Cumulative_WDE_Wrappers/LinearWDE.cpp \
+                Compressed_Cumulative_WDE_Wrappers/math_helpers.cpp
+
+HEADERS     +=  Benchmarking/benchmarkHarness.h \
+                Benchmarking/benchmarkStream.h \
+                Benchmarking/errorsCalculator.h \
+                Benchmarking/stepProfiler.h \
+                Libraries/threadPool.h \
+                DESDA.h
@@ -0,0 +1,25 @@
+#-------------------------------------------------
+#
+# Offline renderer of the curve dumps written by the experiments.
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+TARGET      =   KerDEPDumpRenderer
+TEMPLATE    =   app
+CONFIG      +=  console
+CONFIG      -=  app_bundle
+
+QMAKE_CXXFLAGS += -std=c++17
+
+INCLUDEPATH += $$PWD/
+
+SOURCES     +=  UI/renderCurveDump.cpp \
+                UI/curveDump.cpp \
+                UI/curveDumpRenderer.cpp \
+                Libraries/threadPool.cpp
+
+HEADERS     +=  UI/curveDump.h \
+                UI/curveDumpRenderer.h \
+                Libraries/threadPool.h
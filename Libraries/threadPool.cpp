@@ -0,0 +1,156 @@
+#include "threadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+static thread_local bool is_pool_worker = false;
+
+ThreadPool &ThreadPool::Instance() {
+  /** Returns the pool shared by the whole application. It has one worker less than there are hardware threads, as
+   * the calling thread works too.
+   * @brief Returns the pool shared by the whole application.
+   */
+  static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+ThreadPool::ThreadPool(const size_t &threads_number) {
+  for(size_t i = 0; i < threads_number; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    is_stopping_ = true;
+  }
+
+  tasks_condition_.notify_all();
+
+  for(auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::GetThreadsNumber() const {
+  /** Returns number of threads taking part in the loops, including the calling one.
+   * @brief Returns number of threads taking part in the loops.
+   */
+  return workers_.size() + 1;
+}
+
+void ThreadPool::ParallelFor(const size_t &begin, const size_t &end,
+                             const std::function<void(const size_t &, const size_t &)> &chunk_function,
+                             size_t chunks_number) {
+  /** Splits [begin, end) into contiguous chunks and calls the function for each of them, possibly concurrently.
+   * Returns once all the chunks are processed. Chunks are disjoint, so writing results to chunk-indexed storage
+   * needs no synchronization.
+   * @brief Calls the function for contiguous chunks of the range, possibly concurrently.
+   * @param begin - First index of the range.
+   * @param end - Index after the last one in the range.
+   * @param chunk_function - Function processing [chunk_begin, chunk_end).
+   * @param chunks_number - Number of chunks. If 0, it's equal to number of threads.
+   */
+  if(end <= begin) {
+    return;
+  }
+
+  size_t range_size = end - begin;
+
+  if(chunks_number == 0) {
+    chunks_number = GetThreadsNumber();
+  }
+
+  chunks_number = std::min(chunks_number, range_size);
+
+  if(chunks_number <= 1 || workers_.empty() || is_pool_worker) {
+    chunk_function(begin, end);
+    return;
+  }
+
+  auto remaining_chunks = std::make_shared<std::atomic<size_t>>(chunks_number);
+  auto done_mutex = std::make_shared<std::mutex>();
+  auto done_condition = std::make_shared<std::condition_variable>();
+  auto first_exception = std::make_shared<std::exception_ptr>();
+
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+
+    for(size_t chunk = 0; chunk < chunks_number; ++chunk) {
+      size_t chunk_begin = begin + chunk * range_size / chunks_number;
+      size_t chunk_end = begin + (chunk + 1) * range_size / chunks_number;
+
+      tasks_.emplace_back([=, &chunk_function]() {
+        try {
+          chunk_function(chunk_begin, chunk_end);
+        } catch(...) {
+          std::lock_guard<std::mutex> done_lock(*done_mutex);
+          if(!*first_exception) *first_exception = std::current_exception();
+        }
+
+        if(--(*remaining_chunks) == 0) {
+          std::lock_guard<std::mutex> done_lock(*done_mutex);
+          done_condition->notify_all();
+        }
+      });
+    }
+  }
+
+  tasks_condition_.notify_all();
+
+  // Calling thread helps until the queue is empty, then waits for the chunks that are still processed.
+  while(*remaining_chunks > 0 && TryRunPendingTask()) {}
+
+  {
+    std::unique_lock<std::mutex> lock(*done_mutex);
+    done_condition->wait(lock, [&]() { return *remaining_chunks == 0; });
+  }
+
+  if(*first_exception) {
+    std::rethrow_exception(*first_exception);
+  }
+}
+
+void ThreadPool::WorkerLoop() {
+  is_pool_worker = true;
+
+  while(true) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(tasks_mutex_);
+      tasks_condition_.wait(lock, [&]() { return is_stopping_ || !tasks_.empty(); });
+
+      if(tasks_.empty()) {
+        return;
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
+
+bool ThreadPool::TryRunPendingTask() {
+  std::function<void()> task;
+
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+
+    if(tasks_.empty()) {
+      return false;
+    }
+
+    task = std::move(tasks_.front());
+    tasks_.pop_front();
+  }
+
+  task();
+
+  return true;
+}
@@ -0,0 +1,45 @@
+#ifndef KERDEP_THREADPOOL_H
+#define KERDEP_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+
+    /** Fixed set of worker threads executing data-parallel loops. Workers are created once and live as long as the
+     * pool, so that short loops, e.g. once per drawn frame or per algorithm step, don't pay for thread creation. The
+     * calling thread takes part in the work. Loops started from within a worker are run sequentially.
+     *
+     * @brief Fixed set of worker threads executing data-parallel loops.
+     */
+  public:
+    static ThreadPool &Instance();
+
+    explicit ThreadPool(const size_t &threads_number = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t GetThreadsNumber() const;
+    void ParallelFor(const size_t &begin, const size_t &end,
+                     const std::function<void(const size_t &chunk_begin, const size_t &chunk_end)> &chunk_function,
+                     size_t chunks_number = 0);
+
+  protected:
+    std::vector<std::thread> workers_ = {};
+    std::deque<std::function<void()>> tasks_ = {};
+    std::mutex tasks_mutex_;
+    std::condition_variable tasks_condition_;
+    bool is_stopping_ = false;
+
+    void WorkerLoop();
+    bool TryRunPendingTask();
+};
+
+#endif //KERDEP_THREADPOOL_H
@@ -0,0 +1,37 @@
+#include "vectorDataReader.h"
+#include "../groupingThread/kMedoidsAlgorithm/numericalAttributeData.h"
+
+VectorDataReader::VectorDataReader(const vector<vector<double>> *data) : data_(data) { }
+
+void VectorDataReader::getNextRawDatum(void *target) {
+  vector<double> *targetPtr = static_cast<vector<double> *>(target);
+  targetPtr->clear();
+
+  if(!hasMoreData()) return;
+
+  targetPtr->insert(targetPtr->end(), (*data_)[i].begin(), (*data_)[i].end());
+  ++i;
+}
+
+void VectorDataReader::gatherAttributesData(void *attributes) {
+  auto *attrs_ptr = static_cast<std::unordered_map<std::string, attributeData *> *>(attributes);
+  size_t dimension = data_->empty() ? 0 : data_->front().size();
+
+  for(size_t d = 0; d < dimension; ++d){
+    string attrName = "Val" + std::to_string(d);
+    attributesOrder.push_back(attrName);
+    (*attrs_ptr)[attrName] = new numericalAttributeData(attrName);
+  }
+}
+
+bool VectorDataReader::hasMoreData() {
+  return i < data_->size();
+}
+
+std::vector<std::string> *VectorDataReader::getAttributesOrder() {
+  return &attributesOrder;
+}
+
+size_t VectorDataReader::getCurrentIndex() const {
+  return i;
+}
@@ -0,0 +1,30 @@
+#ifndef KERDEP_VECTORDATAREADER_H
+#define KERDEP_VECTORDATAREADER_H
+
+#include "dataReader.h"
+
+using std::string;
+using std::vector;
+
+class VectorDataReader : public dataReader {
+
+  // Replays data generated beforehand, e.g. so that different estimators can be fed with exactly the same stream.
+  public:
+
+    explicit VectorDataReader(const vector<vector<double>> *data);
+
+    void getNextRawDatum(void *target) override;
+    void gatherAttributesData(void *attributes) override;
+    bool hasMoreData() override;
+
+    std::vector<std::string>* getAttributesOrder() override;
+
+    size_t getCurrentIndex() const;
+
+  protected:
+    vector<string> attributesOrder;
+    const vector<vector<double>> *data_;
+    size_t i = 0;
+};
+
+#endif //KERDEP_VECTORDATAREADER_H
@@ -0,0 +1,202 @@
+#include "curveDump.h"
+
+#include <QDebug>
+#include <QString>
+
+#include <cstring>
+#include <limits>
+
+CurveDumpWriter::~CurveDumpWriter() {
+  Close();
+}
+
+bool CurveDumpWriter::Open(const std::string &path, const std::vector<std::string> &curves_names,
+                           const std::vector<std::string> &scalars_names) {
+  /** Creates the dump file and writes its header. Existing file is overwritten.
+   * @brief Creates the dump file and writes its header.
+   * @param path - Path of the dump file.
+   * @param curves_names - Names of the curves, in order in which they are given in each frame.
+   * @param scalars_names - Names of the scalars, in order in which they are given in each frame.
+   * @return True if the file was created, false otherwise.
+   */
+  Close();
+
+  file_.open(path, std::ios::binary | std::ios::trunc);
+
+  if(!file_.is_open()) {
+    qDebug() << "Couldn't open curve dump " << QString::fromStdString(path) << ".";
+    return false;
+  }
+
+  curves_number_ = curves_names.size();
+  scalars_number_ = scalars_names.size();
+  frames_number_ = 0;
+
+  file_.write(curve_dump::kMagic, sizeof(curve_dump::kMagic));
+  WriteUInt32(curve_dump::kVersion);
+
+  WriteUInt32(static_cast<uint32_t>(curves_number_));
+  for(const auto &name : curves_names) WriteString(name);
+
+  WriteUInt32(static_cast<uint32_t>(scalars_number_));
+  for(const auto &name : scalars_names) WriteString(name);
+
+  return file_.good();
+}
+
+bool CurveDumpWriter::AppendFrame(const CurveDumpFrame &frame) {
+  /** Appends the frame to the dump. Missing curves are written as empty and missing scalars as NaN.
+   * @brief Appends the frame to the dump.
+   * @return True if the frame was written, false otherwise.
+   */
+  if(!file_.is_open()) {
+    return false;
+  }
+
+  WriteUInt32(static_cast<uint32_t>(frame.step_number_));
+  WriteDoubles(frame.domain_);
+
+  for(size_t i = 0; i < curves_number_; ++i) {
+    WriteDoubles(i < frame.curves_.size() ? frame.curves_[i] : std::vector<double>());
+  }
+
+  for(size_t i = 0; i < scalars_number_; ++i) {
+    double value = i < frame.scalars_.size() ? frame.scalars_[i] : std::numeric_limits<double>::quiet_NaN();
+    file_.write(reinterpret_cast<const char *>(&value), sizeof(double));
+  }
+
+  if(!file_.good()) {
+    qDebug() << "Couldn't write frame of step " << frame.step_number_ << " to the curve dump.";
+    return false;
+  }
+
+  ++frames_number_;
+
+  return true;
+}
+
+void CurveDumpWriter::Close() {
+  if(file_.is_open()) {
+    file_.close();
+  }
+}
+
+bool CurveDumpWriter::IsOpen() const {
+  return file_.is_open();
+}
+
+size_t CurveDumpWriter::GetFramesNumber() const {
+  return frames_number_;
+}
+
+void CurveDumpWriter::WriteUInt32(const uint32_t &value) {
+  file_.write(reinterpret_cast<const char *>(&value), sizeof(uint32_t));
+}
+
+void CurveDumpWriter::WriteString(const std::string &text) {
+  WriteUInt32(static_cast<uint32_t>(text.size()));
+  file_.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void CurveDumpWriter::WriteDoubles(const std::vector<double> &values) {
+  WriteUInt32(static_cast<uint32_t>(values.size()));
+  file_.write(reinterpret_cast<const char *>(values.data()),
+              static_cast<std::streamsize>(values.size() * sizeof(double)));
+}
+
+bool CurveDumpReader::Open(const std::string &path) {
+  /** Opens the dump file and reads its header.
+   * @brief Opens the dump file and reads its header.
+   * @return True if the file is a curve dump of supported version, false otherwise.
+   */
+  file_.open(path, std::ios::binary);
+
+  if(!file_.is_open()) {
+    qDebug() << "Couldn't open curve dump " << QString::fromStdString(path) << ".";
+    return false;
+  }
+
+  char magic[sizeof(curve_dump::kMagic)];
+  uint32_t version = 0;
+
+  file_.read(magic, sizeof(magic));
+
+  if(!file_.good() || memcmp(magic, curve_dump::kMagic, sizeof(magic)) != 0
+     || !ReadUInt32(&version) || version != curve_dump::kVersion) {
+    qDebug() << "File " << QString::fromStdString(path) << " isn't a supported curve dump.";
+    return false;
+  }
+
+  uint32_t names_number = 0;
+
+  if(!ReadUInt32(&names_number)) return false;
+  curves_names_.resize(names_number);
+  for(auto &name : curves_names_) if(!ReadString(&name)) return false;
+
+  if(!ReadUInt32(&names_number)) return false;
+  scalars_names_.resize(names_number);
+  for(auto &name : scalars_names_) if(!ReadString(&name)) return false;
+
+  return true;
+}
+
+bool CurveDumpReader::ReadNextFrame(CurveDumpFrame *frame) {
+  /** Reads next frame of the dump.
+   * @brief Reads next frame of the dump.
+   * @return True if the frame was read, false at the end of the dump or if it's malformed.
+   */
+  uint32_t step_number = 0;
+
+  if(!ReadUInt32(&step_number)) {
+    return false;
+  }
+
+  frame->step_number_ = static_cast<int>(step_number);
+
+  if(!ReadDoubles(&frame->domain_)) return false;
+
+  frame->curves_.resize(curves_names_.size());
+  for(auto &curve : frame->curves_) if(!ReadDoubles(&curve)) return false;
+
+  frame->scalars_.resize(scalars_names_.size());
+  file_.read(reinterpret_cast<char *>(frame->scalars_.data()),
+             static_cast<std::streamsize>(frame->scalars_.size() * sizeof(double)));
+
+  return file_.good();
+}
+
+const std::vector<std::string> &CurveDumpReader::GetCurvesNames() const {
+  return curves_names_;
+}
+
+const std::vector<std::string> &CurveDumpReader::GetScalarsNames() const {
+  return scalars_names_;
+}
+
+bool CurveDumpReader::ReadUInt32(uint32_t *value) {
+  file_.read(reinterpret_cast<char *>(value), sizeof(uint32_t));
+  return file_.good();
+}
+
+bool CurveDumpReader::ReadString(std::string *text) {
+  uint32_t length = 0;
+
+  if(!ReadUInt32(&length)) return false;
+
+  text->resize(length);
+  file_.read(&(*text)[0], length);
+
+  return file_.good();
+}
+
+bool CurveDumpReader::ReadDoubles(std::vector<double> *values) {
+  uint32_t values_number = 0;
+
+  if(!ReadUInt32(&values_number)) return false;
+
+  values->resize(values_number);
+  file_.read(reinterpret_cast<char *>(values->data()),
+             static_cast<std::streamsize>(values_number * sizeof(double)));
+
+  return file_.good();
+}
@@ -0,0 +1,76 @@
+#ifndef KERDEP_CURVEDUMP_H
+#define KERDEP_CURVEDUMP_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct CurveDumpFrame {
+  int step_number_ = 0;
+  std::vector<double> domain_ = {};
+  std::vector<std::vector<double>> curves_ = {};  // In order of curves names. Empty if not computed in the step.
+  std::vector<double> scalars_ = {};              // In order of scalars names.
+};
+
+class CurveDumpWriter {
+
+    /** Appends raw curves of the drawn steps to a binary file, so that the frames can be rendered offline (and
+     * rendered again) without recomputing the experiment. File starts with the header (magic, version, names of the
+     * curves and scalars), followed by the frames. Each frame holds step number, domain, values of every curve on
+     * the domain and the scalars. Numbers are stored in the byte order of the machine.
+     *
+     * @brief Appends raw curves of the drawn steps to a binary file.
+     */
+  public:
+    CurveDumpWriter() = default;
+    ~CurveDumpWriter();
+
+    bool Open(const std::string &path, const std::vector<std::string> &curves_names,
+              const std::vector<std::string> &scalars_names);
+    bool AppendFrame(const CurveDumpFrame &frame);
+    void Close();
+
+    bool IsOpen() const;
+    size_t GetFramesNumber() const;
+
+  protected:
+    std::ofstream file_;
+    size_t curves_number_ = 0;
+    size_t scalars_number_ = 0;
+    size_t frames_number_ = 0;
+
+    void WriteUInt32(const uint32_t &value);
+    void WriteString(const std::string &text);
+    void WriteDoubles(const std::vector<double> &values);
+};
+
+class CurveDumpReader {
+
+    /** Reads the files written by CurveDumpWriter, frame by frame.
+     *
+     * @brief Reads the files written by CurveDumpWriter.
+     */
+  public:
+    bool Open(const std::string &path);
+    bool ReadNextFrame(CurveDumpFrame *frame);
+
+    const std::vector<std::string> &GetCurvesNames() const;
+    const std::vector<std::string> &GetScalarsNames() const;
+
+  protected:
+    std::ifstream file_;
+    std::vector<std::string> curves_names_ = {};
+    std::vector<std::string> scalars_names_ = {};
+
+    bool ReadUInt32(uint32_t *value);
+    bool ReadString(std::string *text);
+    bool ReadDoubles(std::vector<double> *values);
+};
+
+namespace curve_dump {
+  const char kMagic[8] = {'K', 'D', 'P', 'C', 'U', 'R', 'V', 'S'};
+  const uint32_t kVersion = 1;
+}
+
+#endif //KERDEP_CURVEDUMP_H
@@ -0,0 +1,119 @@
+#include "curveDumpRenderer.h"
+
+#include <QFont>
+#include <QPainter>
+#include <QPainterPath>
+
+#include <cmath>
+
+CurveDumpRenderer::CurveDumpRenderer(const std::vector<std::string> &curves_names,
+                                     const std::vector<std::string> &scalars_names, const int &width,
+                                     const int &height)
+  : curves_names_(curves_names), scalars_names_(scalars_names), width_(width), height_(height) {
+  // Same pens as on the 1D plot of the main window.
+  curves_pens_["model"] = QPen(Qt::red);
+  curves_pens_["windowed_kde"] = QPen(QColor(255, 220, 0));
+  curves_pens_["kde"] = QPen(QColor(0, 255, 0));
+  curves_pens_["weighted_kde"] = QPen(QColor(0, 255, 255));
+  curves_pens_["enhanced_kde"] = QPen(QColor(0, 0, 255));
+  curves_pens_["rare_elements_kde"] = QPen(Qt::black, 2);
+  curves_pens_["derivative"] = QPen(QColor(255, 165, 0));
+}
+
+void CurveDumpRenderer::SetRanges(const double &min_x, const double &max_x, const double &min_y,
+                                  const double &max_y) {
+  min_x_ = min_x;
+  max_x_ = max_x;
+  min_y_ = min_y;
+  max_y_ = max_y;
+}
+
+void CurveDumpRenderer::SetCurvePen(const std::string &curve_name, const QPen &pen) {
+  curves_pens_[curve_name] = pen;
+}
+
+QImage CurveDumpRenderer::RenderFrame(const CurveDumpFrame &frame) const {
+  /** Renders the frame. It's safe to call concurrently, as the painting is done on the returned image only.
+   * @brief Renders the frame.
+   */
+  QImage image(width_, height_, QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::white);
+
+  QPainter painter(&image);
+  painter.setRenderHint(QPainter::Antialiasing);
+
+  DrawAxes(&painter);
+
+  for(size_t i = 0; i < curves_names_.size() && i < frame.curves_.size(); ++i) {
+    auto pen = curves_pens_.find(curves_names_[i]);
+    DrawCurve(&painter, frame.domain_, frame.curves_[i], pen == curves_pens_.end() ? QPen(Qt::gray) : pen->second);
+  }
+
+  DrawLabels(&painter, frame);
+
+  return image;
+}
+
+void CurveDumpRenderer::DrawAxes(QPainter *painter) const {
+  painter->setPen(QPen(Qt::black));
+  painter->drawLine(ToPixel(min_x_, 0), ToPixel(max_x_, 0));
+  painter->drawRect(QRectF(ToPixel(min_x_, max_y_), ToPixel(max_x_, min_y_)));
+
+  QFont font("Courier New", 10);
+  painter->setFont(font);
+
+  for(double x = std::ceil(min_x_); x <= max_x_; ++x) {
+    auto tick = ToPixel(x, min_y_);
+    painter->drawLine(tick, tick + QPointF(0, 5));
+    painter->drawText(QRectF(tick.x() - 20, tick.y() + 7, 40, 15), Qt::AlignCenter, QString::number(x));
+  }
+}
+
+void CurveDumpRenderer::DrawCurve(QPainter *painter, const std::vector<double> &domain,
+                                  const std::vector<double> &values, const QPen &pen) const {
+  if(values.empty() || values.size() != domain.size()) {
+    return;
+  }
+
+  QPainterPath path(ToPixel(domain[0], values[0]));
+
+  for(size_t i = 1; i < domain.size(); ++i) {
+    path.lineTo(ToPixel(domain[i], values[i]));
+  }
+
+  painter->save();
+  painter->setClipRect(QRectF(ToPixel(min_x_, max_y_), ToPixel(max_x_, min_y_)));
+  painter->setPen(pen);
+  painter->drawPath(path);
+  painter->restore();
+}
+
+void CurveDumpRenderer::DrawLabels(QPainter *painter, const CurveDumpFrame &frame) const {
+  QFont font("Courier New", 14);
+  painter->setFont(font);
+  painter->setPen(QPen(Qt::black));
+
+  int line_height = painter->fontMetrics().height();
+  double x = margin_ + 0.02 * (width_ - 2 * margin_);
+  double y = margin_ + line_height;
+
+  painter->drawText(QPointF(x, y), "t = " + QString::number(frame.step_number_));
+
+  for(size_t i = 0; i < scalars_names_.size() && i < frame.scalars_.size(); ++i) {
+    if(std::isnan(frame.scalars_[i])) {
+      continue;
+    }
+
+    y += line_height;
+    painter->drawText(QPointF(x, y), QString::fromStdString(scalars_names_[i]) + " = "
+                                     + QString::number(frame.scalars_[i], 'f', 7));
+  }
+}
+
+QPointF CurveDumpRenderer::ToPixel(const double &x, const double &y) const {
+  double plot_width = width_ - 2 * margin_;
+  double plot_height = height_ - 2 * margin_;
+
+  return {margin_ + (x - min_x_) / (max_x_ - min_x_) * plot_width,
+          margin_ + (max_y_ - y) / (max_y_ - min_y_) * plot_height};
+}
@@ -0,0 +1,52 @@
+#ifndef KERDEP_CURVEDUMPRENDERER_H
+#define KERDEP_CURVEDUMPRENDERER_H
+
+#include <QImage>
+#include <QPen>
+#include <QPointF>
+#include <QString>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "curveDump.h"
+
+class QPainter;
+
+class CurveDumpRenderer {
+
+    /** Renders frames of the curve dump into images, without any widget, so that it can be used in parallel from
+     * non-GUI threads (each call paints on its own QImage). Frames look like the 1D plots of the main window: curves
+     * are drawn with the same pens and the scalars are listed in the upper left corner.
+     *
+     * @brief Renders frames of the curve dump into images.
+     */
+  public:
+    CurveDumpRenderer(const std::vector<std::string> &curves_names, const std::vector<std::string> &scalars_names,
+                      const int &width = 1920, const int &height = 1080);
+
+    void SetRanges(const double &min_x, const double &max_x, const double &min_y, const double &max_y);
+    void SetCurvePen(const std::string &curve_name, const QPen &pen);
+    QImage RenderFrame(const CurveDumpFrame &frame) const;
+
+  protected:
+    std::vector<std::string> curves_names_ = {};
+    std::vector<std::string> scalars_names_ = {};
+    std::unordered_map<std::string, QPen> curves_pens_ = {};
+    int width_ = 1920;
+    int height_ = 1080;
+    double min_x_ = -5;
+    double max_x_ = 15;
+    double min_y_ = -0.3;
+    double max_y_ = 0.5;
+    const int margin_ = 50;
+
+    void DrawAxes(QPainter *painter) const;
+    void DrawCurve(QPainter *painter, const std::vector<double> &domain, const std::vector<double> &values,
+                   const QPen &pen) const;
+    void DrawLabels(QPainter *painter, const CurveDumpFrame &frame) const;
+    QPointF ToPixel(const double &x, const double &y) const;
+};
+
+#endif //KERDEP_CURVEDUMPRENDERER_H
@@ -0,0 +1,90 @@
+#include "estimatorSnapshotBuffer.h"
+
+#include <algorithm>
+
+EstimatorSnapshotBuffer::EstimatorSnapshotBuffer(const size_t &frames_capacity)
+  : frames_capacity_(std::max<size_t>(frames_capacity, 1)) {}
+
+void EstimatorSnapshotBuffer::PublishLatest(const std::shared_ptr<EstimatorSnapshot> &snapshot) {
+  /** Puts the snapshot to the live slot, giving it next version, and overwrites the one that wasn't taken yet.
+   * Snapshot shouldn't be modified afterwards. Never blocks.
+   * @brief Publishes the live snapshot.
+   */
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if(is_closed_) return;
+
+  snapshot->version_ = ++version_;
+  latest_ = snapshot;
+}
+
+void EstimatorSnapshotBuffer::PublishFrame(const std::shared_ptr<EstimatorSnapshot> &snapshot) {
+  /** Queues the frame, giving it next version. Frame shouldn't be modified afterwards. Only blocks if the queue of
+   * frames is full. Frames published after the buffer was closed are dropped, as nothing will render them.
+   * @brief Publishes the frame.
+   */
+  std::unique_lock<std::mutex> lock(mutex_);
+  frames_taken_condition_.wait(lock, [this] { return is_closed_ || frames_.size() < frames_capacity_; });
+
+  if(is_closed_) return;
+
+  snapshot->version_ = ++version_;
+  frames_.push_back(snapshot);
+}
+
+std::shared_ptr<const EstimatorSnapshot> EstimatorSnapshotBuffer::TakeLatest() {
+  /** Takes the live snapshot, leaving the slot empty.
+   * @brief Takes the live snapshot.
+   * @return Live snapshot or nullptr, if none was published since the last take.
+   */
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<const EstimatorSnapshot> latest = latest_;
+  latest_.reset();
+  return latest;
+}
+
+std::vector<std::shared_ptr<const EstimatorSnapshot>> EstimatorSnapshotBuffer::TakeFrames() {
+  /** Takes the queued frames, in order of publishing.
+   * @brief Takes the queued frames.
+   */
+  std::vector<std::shared_ptr<const EstimatorSnapshot>> frames = {};
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frames.assign(frames_.begin(), frames_.end());
+    frames_.clear();
+  }
+
+  frames_taken_condition_.notify_all();
+
+  return frames;
+}
+
+bool EstimatorSnapshotBuffer::IsLatestTaken() {
+  /** Lets the worker skip preparing the live snapshot while the GUI hasn't taken the previous one yet, as it would be
+   * overwritten anyway.
+   * @brief Checks if the live slot is empty.
+   */
+  std::lock_guard<std::mutex> lock(mutex_);
+  return latest_ == nullptr;
+}
+
+void EstimatorSnapshotBuffer::Close() {
+  /** Stops accepting the snapshots, so that the publisher never waits, e.g. when nothing renders them anymore.
+   * Publisher should check IsClosed and finish early.
+   * @brief Stops accepting the snapshots.
+   */
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_closed_ = true;
+    latest_.reset();
+    frames_.clear();
+  }
+
+  frames_taken_condition_.notify_all();
+}
+
+bool EstimatorSnapshotBuffer::IsClosed() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return is_closed_;
+}
@@ -0,0 +1,74 @@
+#ifndef KERDEP_ESTIMATORSNAPSHOTBUFFER_H
+#define KERDEP_ESTIMATORSNAPSHOTBUFFER_H
+
+#include <QString>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct EstimatorSnapshot {
+  long long version_ = 0;  // Given by the buffer on publishing, increases with each published snapshot.
+  int step_number_ = 0;
+  QString frame_path_ = "";  // Set only for the frames, which are exported.
+
+  // Values of the curves on the drawable domain.
+  std::vector<std::string> curves_names_ = {};
+  std::vector<std::vector<double>> curves_values_ = {};
+
+  // Values presented by the labels.
+  std::unordered_map<std::string, double> double_values_ = {};
+  std::unordered_map<std::string, int> int_values_ = {};
+  std::unordered_map<std::string, QString> text_values_ = {};
+
+  // State of the estimator, from which the GUI evaluates the live curves.
+  std::vector<double> clusters_positions_ = {};
+  std::vector<double> clusters_weights_ = {};
+  std::vector<double> smoothing_parameters_ = {};
+  std::vector<std::pair<double, double>> atypical_elements_values_and_derivatives_ = {};
+  double quantile_estimator_value_ = 0;
+
+  void AddCurve(const std::string &name, const std::vector<double> &values) {
+    curves_names_.push_back(name);
+    curves_values_.push_back(values);
+  }
+};
+
+class EstimatorSnapshotBuffer {
+
+    /** Hands read-only, versioned snapshots of the estimator from the worker thread to the GUI. Worker fills its own
+     * snapshot and publishes it, so the GUI never sees a snapshot that is being written. There are two paths:
+     *  - live snapshots go to a single slot, which publishing overwrites. It never blocks, GUI takes the newest one
+     *    at its own rate and the ones it didn't manage to take are lost.
+     *  - frames, which are exported, go to a bounded queue, in order. It's the only path that blocks the worker,
+     *    and only if the GUI falls behind with exporting the frames.
+     *
+     * @brief Hands read-only snapshots of the estimator from the worker thread to the GUI.
+     */
+  public:
+    explicit EstimatorSnapshotBuffer(const size_t &frames_capacity = 8);
+
+    void PublishLatest(const std::shared_ptr<EstimatorSnapshot> &snapshot);
+    void PublishFrame(const std::shared_ptr<EstimatorSnapshot> &snapshot);
+    std::shared_ptr<const EstimatorSnapshot> TakeLatest();
+    std::vector<std::shared_ptr<const EstimatorSnapshot>> TakeFrames();
+    bool IsLatestTaken();
+    void Close();
+    bool IsClosed();
+
+  protected:
+    size_t frames_capacity_ = 8;
+    bool is_closed_ = false;
+    long long version_ = 0;
+    std::shared_ptr<const EstimatorSnapshot> latest_;
+    std::deque<std::shared_ptr<const EstimatorSnapshot>> frames_ = {};
+    std::mutex mutex_;
+    std::condition_variable frames_taken_condition_;
+};
+
+#endif //KERDEP_ESTIMATORSNAPSHOTBUFFER_H
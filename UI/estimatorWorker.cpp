@@ -0,0 +1,9 @@
+#include "estimatorWorker.h"
+
+#include <utility>
+
+EstimatorWorker::EstimatorWorker(std::function<void()> loop) : loop_(std::move(loop)) {}
+
+void EstimatorWorker::run() {
+  if(loop_) loop_();
+}
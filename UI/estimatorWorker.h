@@ -0,0 +1,24 @@
+#ifndef KERDEP_ESTIMATORWORKER_H
+#define KERDEP_ESTIMATORWORKER_H
+
+#include <QThread>
+
+#include <functional>
+
+class EstimatorWorker : public QThread {
+
+    /** Runs the loop of the experiment (ingestion of the stream and computation of the estimators) on its own
+     * thread, so that the GUI thread only renders what the loop publishes.
+     *
+     * @brief Runs the loop of the experiment on its own thread.
+     */
+  public:
+    explicit EstimatorWorker(std::function<void()> loop);
+
+    void run() override;
+
+  protected:
+    std::function<void()> loop_;
+};
+
+#endif //KERDEP_ESTIMATORWORKER_H
@@ -0,0 +1,103 @@
+#include "frameExportPipeline.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+FrameExportPipeline::FrameExportPipeline(const size_t &workers_number, const size_t &queue_capacity,
+                                         const int &quality)
+  : queue_capacity_(std::max<size_t>(queue_capacity, 1)), quality_(quality) {
+  for(size_t i = 0; i < std::max<size_t>(workers_number, 1); ++i) {
+    workers_.emplace_back(&FrameExportPipeline::WorkerLoop, this);
+  }
+}
+
+FrameExportPipeline::~FrameExportPipeline() {
+  Flush();
+
+  {
+    std::lock_guard<std::mutex> lock(frames_mutex_);
+    is_stopping_ = true;
+  }
+
+  frame_published_condition_.notify_all();
+
+  for(auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void FrameExportPipeline::Publish(const QImage &image, const QString &path, const int &step_number) {
+  /** Queues the frame for the export. Blocks while the queue is full.
+   * @brief Queues the frame for the export.
+   * @param image - Rasterized frame. It's not modified afterwards, as QImage detaches on write.
+   * @param path - Path of the PNG file.
+   * @param step_number - Step of the experiment the frame presents.
+   */
+  std::unique_lock<std::mutex> lock(frames_mutex_);
+  frame_taken_condition_.wait(lock, [this] { return frames_.size() < queue_capacity_; });
+
+  ExportFrame frame;
+  frame.sequence_number_ = published_frames_number_++;
+  frame.step_number_ = step_number;
+  frame.path_ = path;
+  frame.image_ = image;
+
+  frames_.push_back(frame);
+  lock.unlock();
+
+  frame_published_condition_.notify_one();
+}
+
+void FrameExportPipeline::Flush() {
+  /** Waits until all published frames are written.
+   * @brief Waits until all published frames are written.
+   */
+  std::unique_lock<std::mutex> lock(frames_mutex_);
+  frame_exported_condition_.wait(lock, [this] { return frames_.empty() && frames_in_progress_number_ == 0; });
+}
+
+size_t FrameExportPipeline::GetPendingFramesNumber() {
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  return frames_.size() + frames_in_progress_number_;
+}
+
+size_t FrameExportPipeline::GetSavedFramesNumber() {
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  return saved_frames_number_;
+}
+
+size_t FrameExportPipeline::GetFailedFramesNumber() {
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  return failed_frames_number_;
+}
+
+void FrameExportPipeline::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(frames_mutex_);
+
+  while(true) {
+    frame_published_condition_.wait(lock, [this] { return is_stopping_ || !frames_.empty(); });
+
+    if(frames_.empty()) {
+      return; // Stopping and there's nothing left to export.
+    }
+
+    ExportFrame frame = frames_.front();
+    frames_.pop_front();
+    ++frames_in_progress_number_;
+    lock.unlock();
+
+    frame_taken_condition_.notify_one();
+
+    bool was_saved = frame.image_.save(frame.path_, "PNG", quality_);
+
+    if(!was_saved) {
+      qDebug() << "Couldn't save frame of step " << frame.step_number_ << " to " << frame.path_ << ".";
+    }
+
+    lock.lock();
+    --frames_in_progress_number_;
+    ++(was_saved ? saved_frames_number_ : failed_frames_number_);
+    frame_exported_condition_.notify_all();
+  }
+}
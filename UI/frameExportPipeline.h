@@ -0,0 +1,68 @@
+#ifndef KERDEP_FRAMEEXPORTPIPELINE_H
+#define KERDEP_FRAMEEXPORTPIPELINE_H
+
+#include <QImage>
+#include <QString>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ExportFrame {
+  long long sequence_number_ = 0;
+  int step_number_ = 0;
+  QString path_ = "";
+  QImage image_;
+};
+
+class FrameExportPipeline {
+
+    /** Encodes and writes the frames of the experiments in the background. Estimator loop publishes immutable frame
+     * snapshot (rasterized plot along with its step and target path) and continues, while the workers compress it to
+     * PNG and write it on the disk. Queue of pending frames is bounded, so that when the disk can't keep up, the
+     * publishing blocks instead of accumulating images in the memory. Frames are taken by the workers in the order
+     * they were published.
+     *
+     * Rasterization itself has to be done by the publisher, as Qt widgets can only be painted in GUI thread. QImage
+     * is implicitly shared, thus the snapshot doesn't copy the pixels.
+     *
+     * @brief Encodes and writes the frames of the experiments in the background.
+     */
+  public:
+    explicit FrameExportPipeline(const size_t &workers_number = 2, const size_t &queue_capacity = 8,
+                                 const int &quality = -1);
+    ~FrameExportPipeline();
+
+    FrameExportPipeline(const FrameExportPipeline &) = delete;
+    FrameExportPipeline &operator=(const FrameExportPipeline &) = delete;
+
+    void Publish(const QImage &image, const QString &path, const int &step_number);
+    void Flush();
+
+    size_t GetPendingFramesNumber();
+    size_t GetSavedFramesNumber();
+    size_t GetFailedFramesNumber();
+
+  protected:
+    size_t queue_capacity_ = 8;
+    int quality_ = -1;
+    long long published_frames_number_ = 0;
+    size_t frames_in_progress_number_ = 0;
+    size_t saved_frames_number_ = 0;
+    size_t failed_frames_number_ = 0;
+    bool is_stopping_ = false;
+
+    std::vector<std::thread> workers_ = {};
+    std::deque<ExportFrame> frames_ = {};
+    std::mutex frames_mutex_;
+    std::condition_variable frame_published_condition_;
+    std::condition_variable frame_taken_condition_;
+    std::condition_variable frame_exported_condition_;
+
+    void WorkerLoop();
+};
+
+#endif //KERDEP_FRAMEEXPORTPIPELINE_H
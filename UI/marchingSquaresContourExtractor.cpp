@@ -0,0 +1,204 @@
+#include "marchingSquaresContourExtractor.h"
+
+#include <qnumeric.h>
+
+#include <algorithm>
+
+#include "../Libraries/threadPool.h"
+
+MarchingSquaresContourExtractor::MarchingSquaresContourExtractor(const std::vector<double> *grid_values,
+                                                                 const int &columns_number, const int &rows_number,
+                                                                 const QRectF &rect, const double &dx,
+                                                                 const double &dy)
+  : grid_values_(grid_values), columns_number_(columns_number), rows_number_(rows_number), rect_(rect), dx_(dx),
+    dy_(dy) {}
+
+QwtRasterData::ContourLines MarchingSquaresContourExtractor::ExtractContourLines(const QList<double> &levels,
+                                                                                 const bool &ignore_on_plane,
+                                                                                 const bool &ignore_out_of_range,
+                                                                                 const QwtInterval &range) const {
+  /** Extracts contour lines of all the levels. Work is split into (level, rows band) tasks, so that a few levels
+   * still keep all the threads busy. Bands of each level are merged in order, hence the result doesn't depend on
+   * the number of threads.
+   * @brief Extracts contour lines of all the levels.
+   * @param levels - Levels of the contour lines.
+   * @param ignore_on_plane - If true, cells with all vertices on the level are skipped.
+   * @param ignore_out_of_range - If true, cells with values out of the range are skipped.
+   * @param range - Range of valid values.
+   * @return Contour lines as pairs of points, keyed by level.
+   */
+  QwtRasterData::ContourLines contour_lines;
+  int cells_rows_number = rows_number_ - 1;
+
+  if(levels.empty() || cells_rows_number < 1 || columns_number_ < 2
+     || grid_values_->size() < static_cast<size_t>(columns_number_ * rows_number_)) {
+    return contour_lines;
+  }
+
+  size_t levels_number = levels.size();
+  size_t threads_number = ThreadPool::Instance().GetThreadsNumber();
+  // A few bands per thread balance the load, as contours cover only some of the rows.
+  size_t bands_number = (4 * threads_number + levels_number - 1) / levels_number;
+  bands_number = std::max<size_t>(1, std::min<size_t>(bands_number, cells_rows_number));
+  size_t tasks_number = levels_number * bands_number;
+
+  std::vector<QPolygonF> tasks_lines(tasks_number);
+
+  ThreadPool::Instance().ParallelFor(0, tasks_number, [&](const size_t &first_task, const size_t &last_task) {
+    for(size_t task = first_task; task < last_task; ++task) {
+      size_t level_index = task / bands_number;
+      size_t band = task % bands_number;
+      int first_row = static_cast<int>(band * cells_rows_number / bands_number);
+      int last_row = static_cast<int>((band + 1) * cells_rows_number / bands_number);
+
+      ExtractLevelFromRows(levels[static_cast<int>(level_index)], first_row, last_row, ignore_on_plane,
+                           ignore_out_of_range, range, &tasks_lines[task]);
+    }
+  }, tasks_number);
+
+  for(size_t level_index = 0; level_index < levels_number; ++level_index) {
+    QPolygonF lines;
+
+    for(size_t band = 0; band < bands_number; ++band) {
+      lines += tasks_lines[level_index * bands_number + band];
+    }
+
+    if(!lines.isEmpty()) {
+      contour_lines[levels[static_cast<int>(level_index)]] = lines;
+    }
+  }
+
+  return contour_lines;
+}
+
+void MarchingSquaresContourExtractor::ExtractLevelFromRows(const double &level, const int &first_row,
+                                                           const int &last_row, const bool &ignore_on_plane,
+                                                           const bool &ignore_out_of_range,
+                                                           const QwtInterval &range, QPolygonF *lines) const {
+  /** Traces the level over the cells of given rows with marching squares. Vertex is above the level if its value
+   * is not lower than the level.
+   * @brief Traces the level over the cells of given rows.
+   */
+  const std::vector<double> &z = *grid_values_;
+
+  for(int row = first_row; row < last_row; ++row) {
+    const double top_y = rect_.y() + row * dy_;
+    const double bottom_y = top_y + dy_;
+    const size_t top_row_offset = static_cast<size_t>(row) * columns_number_;
+    const size_t bottom_row_offset = top_row_offset + columns_number_;
+
+    for(int column = 0; column < columns_number_ - 1; ++column) {
+      const double top_left = z[top_row_offset + column];
+      const double top_right = z[top_row_offset + column + 1];
+      const double bottom_left = z[bottom_row_offset + column];
+      const double bottom_right = z[bottom_row_offset + column + 1];
+
+      const double z_min = std::min(std::min(top_left, top_right), std::min(bottom_left, bottom_right));
+      const double z_max = std::max(std::max(top_left, top_right), std::max(bottom_left, bottom_right));
+
+      if(qIsNaN(top_left + top_right + bottom_left + bottom_right)) {
+        continue;
+      }
+
+      if(ignore_out_of_range && (!range.contains(z_min) || !range.contains(z_max))) {
+        continue;
+      }
+
+      if(level < z_min || level > z_max) {
+        continue;
+      }
+
+      const double left_x = rect_.x() + column * dx_;
+      const double right_x = left_x + dx_;
+
+      if(z_min == level && z_max == level) {
+        // Whole cell lies on the level, which marching squares can't resolve. As in CONREC, either skip it or
+        // draw one of its edges.
+        if(!ignore_on_plane) {
+          *lines += QPointF(left_x, top_y);
+          *lines += QPointF(right_x, top_y);
+        }
+
+        continue;
+      }
+
+      const int cell_case = (top_left >= level ? 8 : 0) | (top_right >= level ? 4 : 0)
+                            | (bottom_right >= level ? 2 : 0) | (bottom_left >= level ? 1 : 0);
+
+      auto top = [&]() {
+        return Interpolate(level, left_x, top_y, top_left, right_x, top_y, top_right);
+      };
+      auto right = [&]() {
+        return Interpolate(level, right_x, top_y, top_right, right_x, bottom_y, bottom_right);
+      };
+      auto bottom = [&]() {
+        return Interpolate(level, left_x, bottom_y, bottom_left, right_x, bottom_y, bottom_right);
+      };
+      auto left = [&]() {
+        return Interpolate(level, left_x, top_y, top_left, left_x, bottom_y, bottom_left);
+      };
+      auto add_segment = [&](const QPointF &begin, const QPointF &end) {
+        *lines += begin;
+        *lines += end;
+      };
+
+      const bool is_center_above = 0.25 * (top_left + top_right + bottom_left + bottom_right) >= level;
+
+      switch(cell_case) {
+        case 1:
+        case 14:
+          add_segment(left(), bottom());
+          break;
+        case 2:
+        case 13:
+          add_segment(bottom(), right());
+          break;
+        case 3:
+        case 12:
+          add_segment(left(), right());
+          break;
+        case 4:
+        case 11:
+          add_segment(top(), right());
+          break;
+        case 5:
+          // Saddle, top right and bottom left above.
+          if(is_center_above) {
+            add_segment(left(), top());
+            add_segment(bottom(), right());
+          } else {
+            add_segment(top(), right());
+            add_segment(left(), bottom());
+          }
+          break;
+        case 6:
+        case 9:
+          add_segment(top(), bottom());
+          break;
+        case 7:
+        case 8:
+          add_segment(left(), top());
+          break;
+        case 10:
+          // Saddle, top left and bottom right above.
+          if(is_center_above) {
+            add_segment(top(), right());
+            add_segment(left(), bottom());
+          } else {
+            add_segment(left(), top());
+            add_segment(bottom(), right());
+          }
+          break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
+QPointF MarchingSquaresContourExtractor::Interpolate(const double &level, const double &x1, const double &y1,
+                                                     const double &z1, const double &x2, const double &y2,
+                                                     const double &z2) const {
+  const double t = z1 == z2 ? 0.5 : (level - z1) / (z2 - z1);
+  return QPointF(x1 + t * (x2 - x1), y1 + t * (y2 - y1));
+}
@@ -0,0 +1,45 @@
+#ifndef KERDEP_MARCHINGSQUARESCONTOUREXTRACTOR_H
+#define KERDEP_MARCHINGSQUARESCONTOUREXTRACTOR_H
+
+#include <QList>
+#include <QPolygonF>
+#include <QRectF>
+
+#include <qwt_interval.h>
+#include <qwt_raster_data.h>
+
+#include <vector>
+
+class MarchingSquaresContourExtractor {
+
+    /** Extracts contour lines from the values of a function evaluated beforehand on a regular grid. Every cell is
+     * handled with marching squares (saddles resolved with the cell's mean value) and levels are traced in parallel,
+     * in bands of rows. Lines are returned the way QwtRasterData::contourLines returns them, i.e. as pairs of points
+     * forming separate segments, so they can be passed to the spectrogram directly.
+     *
+     * @brief Extracts contour lines from the values of a function evaluated beforehand on a regular grid.
+     */
+  public:
+    MarchingSquaresContourExtractor(const std::vector<double> *grid_values, const int &columns_number,
+                                    const int &rows_number, const QRectF &rect, const double &dx, const double &dy);
+
+    QwtRasterData::ContourLines ExtractContourLines(const QList<double> &levels, const bool &ignore_on_plane,
+                                                    const bool &ignore_out_of_range,
+                                                    const QwtInterval &range) const;
+
+  protected:
+    const std::vector<double> *grid_values_;
+    int columns_number_ = 0;
+    int rows_number_ = 0;
+    QRectF rect_;
+    double dx_ = 0;
+    double dy_ = 0;
+
+    void ExtractLevelFromRows(const double &level, const int &first_row, const int &last_row,
+                              const bool &ignore_on_plane, const bool &ignore_out_of_range,
+                              const QwtInterval &range, QPolygonF *lines) const;
+    QPointF Interpolate(const double &level, const double &x1, const double &y1, const double &z1,
+                        const double &x2, const double &y2, const double &z2) const;
+};
+
+#endif //KERDEP_MARCHINGSQUARESCONTOUREXTRACTOR_H
@@ -0,0 +1,157 @@
+#include "plotCurvesModel.h"
+
+#include <algorithm>
+
+#include "plotLabel.h"
+
+PlotCurvesModel::PlotCurvesModel(QCustomPlot *plot) : plot_(plot) {
+  plot_->addLayer(kPlotLabelsLayerName, plot_->layer("main"), QCustomPlot::limAbove);
+  plot_->layer(kPlotLabelsLayerName)->setMode(QCPLayer::lmBuffered);
+}
+
+void PlotCurvesModel::BeginFrame() {
+  /** Starts the frame. Curves that won't be set until EndFrame will be hidden.
+   * @brief Starts the frame.
+   */
+  for(auto &curve : curves_) {
+    curve.second.was_set_ = false;
+  }
+}
+
+void PlotCurvesModel::SetCurve(const std::string &name, const QVector<double> &keys,
+                               const std::vector<double> &values, const QPen &pen) {
+  /** Updates the curve with given values, creating its graph if it's the first use of the name. Data is passed to
+   * the graph only if it differs from the one already shown.
+   * @brief Updates the curve with given values.
+   * @param name - Name of the curve.
+   * @param keys - Sorted arguments of the values.
+   * @param values - Values of the curve.
+   * @param pen - Pen of the curve.
+   */
+  auto &curve = curves_[name];
+  curve.was_set_ = true;
+
+  if(curve.graph_ == nullptr) {
+    curve.graph_ = plot_->addGraph();
+    curve.graph_->setAdaptiveSampling(false); // Data is already decimated.
+  }
+
+  if(curve.graph_->pen() != pen) {
+    curve.graph_->setPen(pen);
+    are_curves_dirty_ = true;
+  }
+
+  if(!curve.graph_->visible()) {
+    curve.graph_->setVisible(true);
+    are_curves_dirty_ = true;
+  }
+
+  Decimate(keys, values, plot_->axisRect()->width(), &decimated_data_);
+
+  bool is_data_same = decimated_data_.size() == curve.buffer_.size() &&
+                      std::equal(decimated_data_.begin(), decimated_data_.end(), curve.buffer_.begin(),
+                                 [](const QCPGraphData &a, const QCPGraphData &b) {
+                                   return a.key == b.key && a.value == b.value;
+                                 });
+
+  if(is_data_same) {
+    return;
+  }
+
+  std::swap(curve.buffer_, decimated_data_);
+  curve.graph_->data()->set(curve.buffer_, true);
+  are_curves_dirty_ = true;
+}
+
+void PlotCurvesModel::EndFrame() {
+  /** Finishes the frame, hiding curves that weren't set in it.
+   * @brief Finishes the frame.
+   */
+  for(auto &curve : curves_) {
+    if(!curve.second.was_set_ && curve.second.graph_->visible()) {
+      curve.second.graph_->setVisible(false);
+      are_curves_dirty_ = true;
+    }
+  }
+}
+
+void PlotCurvesModel::Clear() {
+  for(auto &curve : curves_) {
+    plot_->removeGraph(curve.second.graph_);
+  }
+
+  curves_.clear();
+  are_curves_dirty_ = true;
+}
+
+void PlotCurvesModel::Invalidate() {
+  /** Marks the plot for full replot, e.g. after the ranges of the axes or the items on the plot were changed.
+   * @brief Marks the plot for full replot.
+   */
+  are_curves_dirty_ = true;
+}
+
+void PlotCurvesModel::Replot() {
+  /** Repaints what has changed since the last replot. If curves (or anything but the labels) have changed, full replot is queued for
+   * the next event loop iteration, so that redundant replots are merged. Otherwise only the labels layer is
+   * repainted.
+   * @brief Repaints what has changed since the last replot.
+   */
+  if(are_curves_dirty_) {
+    plot_->replot(QCustomPlot::rpQueuedReplot);
+    are_curves_dirty_ = false;
+  } else {
+    plot_->layer(kPlotLabelsLayerName)->replot();
+  }
+}
+
+void PlotCurvesModel::Decimate(const QVector<double> &keys, const std::vector<double> &values,
+                               const int &columns_number, QVector<QCPGraphData> *target) {
+  /** Decimates sorted data to given number of pixel columns. For each column the first, the last and the points
+   * with minimal and maximal value are kept, in order of their keys, so that drawn line covers the same pixels as for
+   * the full data. Data that has at most four points per column is copied as it is.
+   * @brief Decimates sorted data to given number of pixel columns.
+   */
+  int points_number = std::min(keys.size(), static_cast<int>(values.size()));
+
+  target->resize(0);
+
+  if(columns_number <= 0 || points_number <= 4 * columns_number || keys[points_number - 1] <= keys[0]) {
+    target->reserve(points_number);
+
+    for(int i = 0; i < points_number; ++i) {
+      target->push_back(QCPGraphData(keys[i], values[i]));
+    }
+
+    return;
+  }
+
+  target->reserve(4 * columns_number);
+
+  double column_width = (keys[points_number - 1] - keys[0]) / columns_number;
+  int column_begin = 0;
+
+  while(column_begin < points_number) {
+    int column = std::min(static_cast<int>((keys[column_begin] - keys[0]) / column_width), columns_number - 1);
+    int min_index = column_begin, max_index = column_begin;
+    int i = column_begin + 1;
+
+    for(; i < points_number
+          && std::min(static_cast<int>((keys[i] - keys[0]) / column_width), columns_number - 1) == column; ++i) {
+      if(values[i] < values[min_index]) min_index = i;
+      if(values[i] > values[max_index]) max_index = i;
+    }
+
+    int kept_indices[4] = {column_begin, std::min(min_index, max_index), std::max(min_index, max_index), i - 1};
+    int last_kept_index = -1;
+
+    for(auto index : kept_indices) {
+      if(index == last_kept_index) continue;
+
+      target->push_back(QCPGraphData(keys[index], values[index]));
+      last_kept_index = index;
+    }
+
+    column_begin = i;
+  }
+}
@@ -0,0 +1,52 @@
+#ifndef KERDEP_PLOTCURVESMODEL_H
+#define KERDEP_PLOTCURVESMODEL_H
+
+#include <QPen>
+#include <QString>
+#include <QVector>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "QCustomPlot/qcustomplot.h"
+
+class PlotCurvesModel {
+
+    /** Persistent curves of the 1D plot. Graph of each curve is created once, on its first use, and later on only its
+     * data is replaced, in place, from the preallocated buffer. Curves that weren't set in a frame are hidden instead
+     * of removed. Data is decimated to the resolution of the plot (minimum and maximum of each pixel column), as
+     * more points can't be seen anyway.
+     *
+     * Labels are kept on their own buffered layer, so that when only they change, only their layer is repainted.
+     *
+     * @brief Persistent curves of the 1D plot.
+     */
+  public:
+    explicit PlotCurvesModel(QCustomPlot *plot);
+
+    void BeginFrame();
+    void SetCurve(const std::string &name, const QVector<double> &keys, const std::vector<double> &values,
+                  const QPen &pen);
+    void EndFrame();
+    void Clear();
+    void Invalidate();
+    void Replot();
+
+    static void Decimate(const QVector<double> &keys, const std::vector<double> &values, const int &columns_number,
+                         QVector<QCPGraphData> *target);
+
+  protected:
+    struct Curve {
+      QCPGraph *graph_ = nullptr;
+      QVector<QCPGraphData> buffer_ = {};
+      bool was_set_ = false;
+    };
+
+    QCustomPlot *plot_ = nullptr;
+    std::unordered_map<std::string, Curve> curves_ = {};
+    QVector<QCPGraphData> decimated_data_ = {};
+    bool are_curves_dirty_ = true;
+};
+
+#endif //KERDEP_PLOTCURVESMODEL_H
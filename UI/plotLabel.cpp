@@ -11,6 +11,10 @@ plotLabel::plotLabel(QCustomPlot *plot, const double &hOffset,
   _label.position->setCoords(hOffset, vOffset);
   _label.setFont(_label_font);
 
+  if(plot->layer(kPlotLabelsLayerName) != nullptr) {
+    _label.setLayer(kPlotLabelsLayerName);
+  }
+
   if(_value == nullptr){
     _label.setText(text);
   } else {
@@ -27,11 +31,14 @@ plotLabel::plotLabel(const plotLabel &pl) :
   _label.position->setCoords(pl._label.position->coords().x(),
                              pl._label.position->coords().y());
   _label.setFont(_label_font);
+  _label.setLayer(pl._label.layer());
   _label.setText(pl._label.text());
 }
 
 void plotLabel::setText(QString text)
 {
+  // Unchanged text shouldn't mark the label for repaint.
+  if(_label.text() == text) return;
   _label.setText(text);
 }
 
@@ -43,7 +50,7 @@ void plotLabel::setFont(const QFont &newFont)
 void plotLabel::updateText()
 {
   if(_value == nullptr) return;
-  _label.setText(_text + _dataPreparator->prepareValue(_value));
+  setText(_text + _dataPreparator->prepareValue(_value));
 }
 
 void plotLabel::SetColor(const QColor &color) {
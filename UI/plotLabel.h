@@ -4,6 +4,9 @@
 #include "QCustomPlot/qcustomplot.h"
 #include "i_plotLabelDataPreparator.h"
 
+// Layer of the labels. If plot has it, labels are placed on it, so that it can be repainted separately.
+const QString kPlotLabelsLayerName = "labels";
+
 class plotLabel
 {
   public:
@@ -0,0 +1,123 @@
+// Offline renderer of the curve dumps written by the experiments. Frames are rendered and encoded in parallel, in
+// batches, so that only a few frames are kept in the memory at once.
+//
+// Usage: KerDEPDumpRenderer <dump path> [--output=<directory>] [--width=<px>] [--height=<px>]
+//                           [--min-x=<x>] [--max-x=<x>] [--min-y=<y>] [--max-y=<y>]
+// Frames are written as <step>.png, like the ones generated by the experiments. By default they're written next to
+// the dump.
+
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QString>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "curveDump.h"
+#include "curveDumpRenderer.h"
+#include "../Libraries/threadPool.h"
+
+struct RendererSettings {
+  std::string dump_path_ = "";
+  std::string output_directory_ = "";
+  int width_ = 1920;
+  int height_ = 1080;
+  double min_x_ = -5;
+  double max_x_ = 15;
+  double min_y_ = -0.3;
+  double max_y_ = 0.5;
+};
+
+RendererSettings ParseArguments(int argc, char *argv[]) {
+  RendererSettings settings;
+
+  for(int i = 1; i < argc; ++i) {
+    std::string argument = argv[i];
+    size_t separator_position = argument.find('=');
+    std::string key = argument.substr(0, separator_position);
+    std::string value = separator_position == std::string::npos ? "" : argument.substr(separator_position + 1);
+
+    if(key == "--output") settings.output_directory_ = value;
+    else if(key == "--width") settings.width_ = std::stoi(value);
+    else if(key == "--height") settings.height_ = std::stoi(value);
+    else if(key == "--min-x") settings.min_x_ = std::stod(value);
+    else if(key == "--max-x") settings.max_x_ = std::stod(value);
+    else if(key == "--min-y") settings.min_y_ = std::stod(value);
+    else if(key == "--max-y") settings.max_y_ = std::stod(value);
+    else if(key.rfind("--", 0) != 0) settings.dump_path_ = argument;
+    else std::cerr << "Unknown argument: " << argument << "\n";
+  }
+
+  if(settings.output_directory_.empty() && !settings.dump_path_.empty()) {
+    settings.output_directory_ =
+        QFileInfo(QString::fromStdString(settings.dump_path_)).absolutePath().toStdString();
+  }
+
+  return settings;
+}
+
+int main(int argc, char *argv[]) {
+  // Needed for fonts, even though nothing is shown.
+  QGuiApplication application(argc, argv);
+
+  RendererSettings settings = ParseArguments(argc, argv);
+
+  if(settings.dump_path_.empty()) {
+    std::cerr << "Usage: KerDEPDumpRenderer <dump path> [--output=<directory>] [--width=<px>] [--height=<px>] "
+                 "[--min-x=<x>] [--max-x=<x>] [--min-y=<y>] [--max-y=<y>]\n";
+    return 1;
+  }
+
+  CurveDumpReader reader;
+
+  if(!reader.Open(settings.dump_path_)) {
+    std::cerr << "Couldn't read " << settings.dump_path_ << ".\n";
+    return 1;
+  }
+
+  QDir output_directory(QString::fromStdString(settings.output_directory_));
+  if(!output_directory.exists()) QDir().mkpath(output_directory.absolutePath());
+
+  CurveDumpRenderer renderer(reader.GetCurvesNames(), reader.GetScalarsNames(), settings.width_, settings.height_);
+  renderer.SetRanges(settings.min_x_, settings.max_x_, settings.min_y_, settings.max_y_);
+
+  auto &pool = ThreadPool::Instance();
+  const size_t batch_size = 4 * pool.GetThreadsNumber();
+  std::vector<CurveDumpFrame> frames(batch_size);
+  std::vector<char> were_saved(batch_size, 0);
+  size_t rendered_frames_number = 0;
+  size_t failed_frames_number = 0;
+  bool is_dump_finished = false;
+
+  while(!is_dump_finished) {
+    size_t frames_number = 0;
+
+    while(frames_number < batch_size && !is_dump_finished) {
+      if(reader.ReadNextFrame(&frames[frames_number])) ++frames_number;
+      else is_dump_finished = true;
+    }
+
+    pool.ParallelFor(0, frames_number, [&](const size_t &chunk_begin, const size_t &chunk_end) {
+      for(size_t i = chunk_begin; i < chunk_end; ++i) {
+        QString image_path = output_directory.filePath(QString::number(frames[i].step_number_) + ".png");
+        were_saved[i] = renderer.RenderFrame(frames[i]).save(image_path, "PNG");
+      }
+    }, frames_number);
+
+    for(size_t i = 0; i < frames_number; ++i) {
+      if(!were_saved[i]) {
+        std::cerr << "Couldn't save frame of step " << frames[i].step_number_ << ".\n";
+        ++failed_frames_number;
+      }
+    }
+
+    rendered_frames_number += frames_number;
+  }
+
+  std::cout << "Rendered " << rendered_frames_number - failed_frames_number << " of " << rendered_frames_number
+            << " frames.\n";
+
+  return failed_frames_number == 0 ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#include "clusterPairDistanceCache.h"
+
+#include <algorithm>
+
+clusterPairDistanceCache::clusterPairDistanceCache(size_t capacity)
+{
+  // Capacity is rounded up to a power of 2, so that slots are found with a mask.
+  size_t slotsNumber = MAX_PROBES_NUMBER;
+
+  while(slotsNumber < capacity) slotsNumber <<= 1;
+
+  entries.resize(slotsNumber);
+  mask = slotsNumber - 1;
+}
+
+/** clusterPairDistanceCache::getDistance
+ * @brief Looks for the distance between clusters of given indices.
+ * @param distance - Set to the cached distance, if it's found.
+ * @return True if the distance is cached.
+ */
+bool clusterPairDistanceCache::getDistance(unsigned int firstIndex, unsigned int secondIndex, double *distance)
+{
+  uint64_t key = getKey(firstIndex, secondIndex);
+  size_t slot = getHomeSlot(key);
+
+  for(int probe = 0; probe < MAX_PROBES_NUMBER; ++probe)
+  {
+    const entry &e = entries[(slot + probe) & mask];
+
+    if(e.epoch != epoch) break; // Pair would be stored here (or earlier).
+
+    if(e.key == key)
+    {
+      ++hitsNumber;
+      *distance = e.distance;
+      return true;
+    }
+  }
+
+  ++missesNumber;
+
+  return false;
+}
+
+void clusterPairDistanceCache::setDistance(unsigned int firstIndex, unsigned int secondIndex, double distance)
+{
+  uint64_t key = getKey(firstIndex, secondIndex);
+  size_t slot = getHomeSlot(key);
+  size_t targetSlot = slot;
+
+  for(int probe = 0; probe < MAX_PROBES_NUMBER; ++probe)
+  {
+    size_t currentSlot = (slot + probe) & mask;
+    const entry &e = entries[currentSlot];
+
+    if(e.epoch != epoch || e.key == key)
+    {
+      targetSlot = currentSlot;
+      break;
+    }
+  }
+
+  entries[targetSlot].key = key;
+  entries[targetSlot].epoch = epoch;
+  entries[targetSlot].distance = distance;
+}
+
+/** clusterPairDistanceCache::invalidate
+ * @brief Drops all cached distances.
+ */
+void clusterPairDistanceCache::invalidate()
+{
+  if(++epoch == 0)
+  {
+    // Epochs wrapped around, so old entries could look valid.
+    for(entry &e : entries) e.epoch = 0;
+    epoch = 1;
+  }
+}
+
+unsigned long long clusterPairDistanceCache::getHitsNumber()
+{
+  return hitsNumber;
+}
+
+unsigned long long clusterPairDistanceCache::getMissesNumber()
+{
+  return missesNumber;
+}
+
+uint64_t clusterPairDistanceCache::getKey(unsigned int firstIndex, unsigned int secondIndex)
+{
+  if(firstIndex > secondIndex) std::swap(firstIndex, secondIndex);
+
+  return (uint64_t(firstIndex) << 32) | secondIndex;
+}
+
+size_t clusterPairDistanceCache::getHomeSlot(uint64_t key)
+{
+  // Fibonacci hashing spreads consecutive indices over the table.
+  return size_t((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
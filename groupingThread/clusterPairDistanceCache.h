@@ -0,0 +1,53 @@
+#ifndef CLUSTERPAIRDISTANCECACHE_H
+#define CLUSTERPAIRDISTANCECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** Cache of distances between pairs of clusters, identified by their indices
+ * (e.g. positions in the grouped clusters vector). Distance is assumed to be
+ * symmetric, so pair (i, j) and (j, i) share one entry. Entries are kept in
+ * open-addressed table of fixed capacity, so memory is bounded. If all slots
+ * probed for new pair are taken, the first of them is overwritten.
+ *
+ * Indices mean nothing to the cache, so whoever changes what they refer to
+ * (e.g. moves the means) has to invalidate it. Invalidation only changes the
+ * current epoch, so it's O(1).
+ */
+class clusterPairDistanceCache
+{
+  public:
+
+    clusterPairDistanceCache(size_t capacity = 1 << 16);
+
+    bool getDistance(unsigned int firstIndex, unsigned int secondIndex, double *distance);
+    void setDistance(unsigned int firstIndex, unsigned int secondIndex, double distance);
+    void invalidate();
+
+    unsigned long long getHitsNumber();
+    unsigned long long getMissesNumber();
+
+  protected:
+
+    struct entry
+    {
+      uint64_t key = 0;
+      unsigned int epoch = 0; // Entry is valid if its epoch is current.
+      double distance = 0.0;
+    };
+
+    static const int MAX_PROBES_NUMBER = 8;
+
+    std::vector<entry> entries;
+    size_t mask = 0;
+    unsigned int epoch = 1;
+
+    unsigned long long hitsNumber = 0;
+    unsigned long long missesNumber = 0;
+
+    uint64_t getKey(unsigned int firstIndex, unsigned int secondIndex);
+    size_t getHomeSlot(uint64_t key);
+};
+
+#endif // CLUSTERPAIRDISTANCECACHE_H
@@ -19,6 +19,12 @@ groupingThread::groupingThread(std::vector<std::shared_ptr<cluster>> *medoidsSto
   this->parser = parser;
 }
 
+groupingThread::~groupingThread()
+{
+  // Grouping in progress uses members of the thread.
+  wait();
+}
+
 int groupingThread::initialize(int medoidsNumber, int bufferSize)
 {
   int NUMBER_OF_MEDOIDS = medoidsNumber;
@@ -45,9 +51,98 @@ int groupingThread::initialize(int medoidsNumber, int bufferSize)
 
 void groupingThread::run()
 {
-  storingAlgorithm->findAndStoreMedoidsFromClusters(&clusters, medoidsStorage);
+  storingAlgorithm->findAndStoreMedoidsFromClusters(&clusters, &backMedoids);
+  publishMedoids();
+
+  qDebug() << "Grouping finished and medoids published.";
+}
+
+/** groupingThread::groupClustersInBackground
+ * @brief Starts grouping of the snapshot of the clusters, unless previous
+ * grouping is still running. Clusters are copied, so that they can be further
+ * updated by the stream during the grouping. New medoids are stored on top of
+ * the copy of the storage (or of the last published set, if it wasn't applied
+ * yet), so that each published set contains earlier medoids too.
+ * @return True if the grouping was started.
+ */
+bool groupingThread::groupClustersInBackground(const std::vector<std::shared_ptr<cluster> > &clusters)
+{
+  if(isRunning()) return false;
+
+  this->clusters.clear();
+
+  for(auto c : clusters)
+    this->clusters.push_back(std::make_shared<cluster>(*c));
+
+  // Storage is more recent than the published set once the set was applied,
+  // e.g. when it holds the clusters updated by the stream.
+  std::shared_ptr<const medoidsVector> medoids = getPublishedMedoids();
+  bool isStorageRecent = !medoids || appliedMedoidsEpoch == getMedoidsEpoch();
+  const medoidsVector &lastMedoids = isStorageRecent ? *medoidsStorage : *medoids;
+
+  backMedoids.clear();
+
+  for(auto m : lastMedoids)
+    backMedoids.push_back(std::make_shared<cluster>(*m));
+
+  start();
+
+  return true;
+}
+
+/** groupingThread::getMedoidsEpoch
+ * @brief Returns number of medoids sets published so far. It changes right after
+ * the new set is published.
+ */
+unsigned long long groupingThread::getMedoidsEpoch()
+{
+  return medoidsEpoch.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<const medoidsVector> groupingThread::getPublishedMedoids()
+{
+  return std::atomic_load(&publishedMedoids);
+}
+
+/** groupingThread::applyPublishedMedoids
+ * @brief Replaces content of the medoids storage with the last published
+ * medoids, if they weren't applied yet. Should be called on the thread that uses
+ * the storage.
+ * @return Epoch of the medoids in the storage.
+ */
+unsigned long long groupingThread::applyPublishedMedoids()
+{
+  unsigned long long epoch = getMedoidsEpoch();
+
+  if(epoch == appliedMedoidsEpoch) return appliedMedoidsEpoch;
+
+  auto medoids = getPublishedMedoids();
+
+  if(medoids) *medoidsStorage = *medoids;
+
+  appliedMedoidsEpoch = epoch;
+
+  return appliedMedoidsEpoch;
+}
+
+std::vector<std::shared_ptr<cluster>> *groupingThread::getMedoidsStorage()
+{
+  return medoidsStorage;
+}
+
+/** groupingThread::publishMedoids
+ * @brief Moves back buffer into new published medoids set and increases the
+ * epoch. The set is published before the epoch changes, so whoever sees the new
+ * epoch gets at least as recent medoids.
+ */
+void groupingThread::publishMedoids()
+{
+  std::shared_ptr<const medoidsVector> medoids =
+      std::make_shared<const medoidsVector>(std::move(backMedoids));
+  backMedoids.clear();
 
-  qDebug() << "Grouping finished and medoids stored.";
+  std::atomic_store(&publishedMedoids, medoids);
+  medoidsEpoch.fetch_add(1, std::memory_order_release);
 }
 
 int groupingThread::getObjectsForGrouping(std::vector<std::shared_ptr<sample>> samples)
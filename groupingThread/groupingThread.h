@@ -10,16 +10,26 @@
 
 #include <QThread>
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 #include <memory>
 
+typedef std::vector<std::shared_ptr<cluster>> medoidsVector;
+
+/** Groups clusters into medoids concurrently with the stream. Grouping works on
+ * a snapshot of the clusters and stores medoids in a back buffer, which is then
+ * published at once, as an immutable vector, and the medoids epoch is
+ * increased. Live medoids storage is only changed by applyPublishedMedoids, on
+ * the thread that owns it, so the stream isn't stopped for the grouping.
+ */
 class groupingThread : public QThread
 {
   public:
 
     groupingThread(std::vector<std::shared_ptr<cluster> > *medoidsStorage,
                    std::shared_ptr<dataParser> parser);
+    ~groupingThread();
     void run();
     int initialize(int medoidsNumber, int bufferSize);
 
@@ -27,6 +37,12 @@ class groupingThread : public QThread
     int getClustersForGrouping(std::vector<std::shared_ptr<cluster> > clusters);
     int setAttributesData(std::unordered_map<std::string, attributeData*>* attributesData);
 
+    bool groupClustersInBackground(const std::vector<std::shared_ptr<cluster> > &clusters);
+    unsigned long long getMedoidsEpoch();
+    std::shared_ptr<const medoidsVector> getPublishedMedoids();
+    unsigned long long applyPublishedMedoids();
+    std::vector<std::shared_ptr<cluster>> *getMedoidsStorage();
+
   protected:
 
     std::vector<std::shared_ptr<sample>> objects;
@@ -39,7 +55,15 @@ class groupingThread : public QThread
     std::unique_ptr<medoidStoringAlgorithm> storingAlgorithm;
 
     std::vector<std::shared_ptr<cluster>> *medoidsStorage;
+    unsigned long long appliedMedoidsEpoch = 0;
+
+    // Double buffer of medoids. Back one is only used by the grouping, published
+    // one is only accessed with atomic operations.
+    medoidsVector backMedoids;
+    std::shared_ptr<const medoidsVector> publishedMedoids;
+    std::atomic<unsigned long long> medoidsEpoch{0};
 
+    void publishMedoids();
 
 };
 
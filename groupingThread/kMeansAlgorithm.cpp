@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <limits>
 
+#include "numericalKMeans.h"
+
 #include <QDebug>
 
 kMeansAlgorithm::kMeansAlgorithm(int numberOfClusters,
@@ -69,14 +71,35 @@ void kMeansAlgorithm::clusterObjects(std::vector<std::shared_ptr<sample>> *objec
   }
 }
 
+/** kMeansAlgorithm::setNumericalGrouping
+ * @brief Enables grouping of all-numerical clusters with numericalKMeans. It's
+ * faster, but it's not the same algorithm as the generic path, even for one
+ * dimensional data:
+ *  - attributes are scaled by the ranges of the grouped clusters, not by the
+ *    ones from attributes data used by Gower's distance,
+ *  - distance is Euclidean instead of Gower's (range-scaled L1), hence the
+ *    assignment error and its absolute stop threshold differ in scale,
+ *  - positions are read from representatives, not from the objects,
+ *  - mean with no weighted clusters keeps its position, instead of being
+ *    moved to 0.
+ * Hence it's disabled by default.
+ * @param isEnabled - Whether numerical grouping is used.
+ */
+void kMeansAlgorithm::setNumericalGrouping(bool isEnabled)
+{
+  isNumericalGroupingEnabled = isEnabled;
+}
+
 int kMeansAlgorithm::performGrouping(
     std::vector<std::shared_ptr<cluster> > *target)
 {
   findInitialMeans();
 
+  if(isNumericalGroupingEnabled && performNumericalGrouping(target))
+    return target->size();
+
   double oldError = 0.0;
   double newError = std::numeric_limits<double>::max();
-  double errorThreshold = 1.0e-5;
 
   do
   {
@@ -166,6 +189,132 @@ int kMeansAlgorithm::performGrouping(
   return target->size();
 }
 
+/** kMeansAlgorithm::performNumericalGrouping
+ * @brief Performs grouping with numericalKMeans, if all attributes of the
+ * clusters are numerical. Attributes are scaled by their ranges and distance
+ * between them is Euclidean, see setNumericalGrouping. Initial means have to be
+ * found already.
+ * @return False if some attribute isn't numerical and generic grouping should
+ * be performed instead.
+ */
+bool kMeansAlgorithm::performNumericalGrouping(
+    std::vector<std::shared_ptr<cluster> > *target)
+{
+  std::vector<std::string> *attributesOrder = clusters[0]->getRepresentative()->attirbutesOrder;
+
+  if(attributesOrder == nullptr || attributesOrder->empty()) return false;
+
+  int dimension = attributesOrder->size();
+
+  std::vector<double> points, weights, initialMeans, values;
+
+  for(std::shared_ptr<cluster> c : clusters)
+  {
+    if(!getNumericalValues(c->getRepresentative(), attributesOrder, &values))
+      return false;
+
+    points.insert(points.end(), values.begin(), values.end());
+    weights.push_back(c->representsObject() ? c->getWeight() : 0.0);
+  }
+
+  for(std::shared_ptr<cluster> mean : means)
+  {
+    if(!getNumericalValues(mean->getRepresentative(), attributesOrder, &values))
+      return false;
+
+    initialMeans.insert(initialMeans.end(), values.begin(), values.end());
+  }
+
+  // Scale attributes by their ranges.
+  std::vector<double> scales(dimension, 1.0);
+
+  for(int a = 0; a < dimension; ++a)
+  {
+    double minValue = points[a], maxValue = points[a];
+
+    for(size_t i = a; i < points.size(); i += dimension)
+    {
+      minValue = std::min(minValue, points[i]);
+      maxValue = std::max(maxValue, points[i]);
+    }
+
+    if(maxValue > minValue) scales[a] = 1.0 / (maxValue - minValue);
+  }
+
+  for(size_t i = 0; i < points.size(); ++i)
+    points[i] *= scales[i % dimension];
+
+  for(size_t i = 0; i < initialMeans.size(); ++i)
+    initialMeans[i] *= scales[i % dimension];
+
+  numericalKMeans engine(dimension);
+  engine.setPoints(points, weights);
+  engine.setMeans(initialMeans);
+  engine.group(errorThreshold);
+
+  // Create means clusters and assign clusters to them.
+  std::vector<double> finalMeans = engine.getMeans();
+  std::vector<std::shared_ptr<sample>> newMeans;
+
+  for(size_t c = 0; c < means.size(); ++c)
+  {
+    parser->addDatumToContainer(&newMeans);
+    std::shared_ptr<sample> currentMean = newMeans[newMeans.size() - 1];
+    currentMean->attributesData = clusters[0]->getRepresentative()->attributesData;
+
+    for(int a = 0; a < dimension; ++a)
+    {
+      currentMean->attributesValues[attributesOrder->at(a)] =
+        std::to_string(finalMeans[c * dimension + a] / scales[a]);
+    }
+  }
+
+  target->clear();
+
+  for(std::shared_ptr<sample> mean : newMeans)
+    target->push_back(std::shared_ptr<cluster>(new cluster(std::shared_ptr<sample>(mean), true)));
+
+  const std::vector<int> &assignments = engine.getAssignments();
+
+  for(size_t i = 0; i < clusters.size(); ++i)
+    target->at(assignments[i])->addSubcluster(clusters[i]);
+
+  return true;
+}
+
+/** kMeansAlgorithm::getNumericalValues
+ * @brief Parses values of the object's attributes, in given order.
+ * @return False if some value isn't a number.
+ */
+bool kMeansAlgorithm::getNumericalValues(std::shared_ptr<sample> object,
+                                         std::vector<std::string> *attributesOrder,
+                                         std::vector<double> *values)
+{
+  values->clear();
+
+  for(std::string attribute : *attributesOrder)
+  {
+    auto value = object->attributesValues.find(attribute);
+
+    if(value == object->attributesValues.end()) return false;
+
+    size_t parsedCharactersNumber = 0;
+
+    try
+    {
+      values->push_back(std::stod(value->second, &parsedCharactersNumber));
+    }
+    catch(std::exception &e)
+    {
+      return false;
+    }
+
+    if(parsedCharactersNumber != value->second.size()) return false;
+  }
+
+  return true;
+}
+
 int kMeansAlgorithm::findInitialMeans()
 {
   switch(this->initialMeansFindingStrategy)
@@ -252,33 +401,68 @@ int kMeansAlgorithm::findRandomMeans()
   return means.size();
 }
 
+/** kMeansAlgorithm::findMeansAccordingToDistance
+ * @brief k-means++ seeding. Each cluster keeps squared distance to its nearest
+ * mean, which is updated with distances to the newly added mean only, so that
+ * each mean costs one distance per cluster. Next mean is drawn with
+ * probability proportional to these distances, by binary search in their
+ * prefix sums.
+ */
 int kMeansAlgorithm::findMeansAccordingToDistance()
 {
   means.clear();
 
-  // Create and fill vector of clusters indexes
-  std::vector<int> nonMeanIndexes;
+  if(!isRandomNumberGeneratorSeeded) setSeed(rand());
 
-  for(unsigned int i = 0; i < clusters.size(); ++i)
-    nonMeanIndexes.push_back(i);
+  std::vector<double> nearestMeansDistances(clusters.size(), std::numeric_limits<double>::max());
+  std::vector<double> distancesPrefixSums(clusters.size(), 0.0);
+  std::vector<char> isMean(clusters.size(), 0);
 
   // Select first medoid at random (uniformly) and add it to vector
-  int nonMeanPosition = rand() % nonMeanIndexes.size();
-  int newMeanIndex = nonMeanIndexes.at(nonMeanPosition);
+  std::uniform_int_distribution<size_t> indexDistribution(0, clusters.size() - 1);
+  size_t newMeanIndex = indexDistribution(randomNumberGenerator);
 
-  //qDebug() << "Adding mean.";
-  addNewMeanToMeansVector(newMeanIndex);
+  while(true)
+  {
+    addNewMeanToMeansVector(newMeanIndex);
+    nearestMeansDistances[newMeanIndex] = 0;
+    isMean[newMeanIndex] = 1;
 
-  //qDebug() << "Erasing index.";
-  nonMeanIndexes.erase(nonMeanIndexes.begin() + nonMeanPosition);
+    if(means.size() >= numberOfClusters) break;
 
-  //qDebug() << "Filling means indices.";
-  while(means.size() < numberOfClusters)
-  {
-    addNewMedoidAccordingToDistanceToMeansVector(&nonMeanIndexes);
+    double distancesSum = 0;
+
+    for(size_t i = 0; i < clusters.size(); ++i)
+    {
+      if(nearestMeansDistances[i] > 0)
+      {
+        double distance = clusDistanceMeasure->countClustersDistance(clusters[newMeanIndex].get(),
+                                                                     clusters[i].get());
+        nearestMeansDistances[i] = std::min(nearestMeansDistances[i], distance * distance);
+      }
+
+      distancesSum += nearestMeansDistances[i];
+      distancesPrefixSums[i] = distancesSum;
+    }
+
+    if(distancesSum <= 0)
+    {
+      // Remaining clusters coincide with the means, take the first of them.
+      newMeanIndex = std::find(isMean.begin(), isMean.end(), 0) - isMean.begin();
+      continue;
+    }
+
+    std::uniform_real_distribution<double> prefixSumDistribution(0.0, distancesSum);
+    double r = prefixSumDistribution(randomNumberGenerator);
+
+    newMeanIndex = std::upper_bound(distancesPrefixSums.begin(), distancesPrefixSums.end(), r)
+                   - distancesPrefixSums.begin();
+    newMeanIndex = std::min(newMeanIndex, clusters.size() - 1);
+
+    // Only possible due to rounding at the very end of the prefix sums.
+    while(isMean[newMeanIndex]) --newMeanIndex;
   }
 
-  //qDebug() << "Creating means clusters.";
   // Create distinct, new clusters for means
   for(int i = 0; i < means.size(); ++i)
   {
@@ -297,77 +481,14 @@ int kMeansAlgorithm::addNewMeanToMeansVector(int meanIndex)
   return means.size();
 }
 
-int kMeansAlgorithm::addNewMedoidAccordingToDistanceToMeansVector(
-    std::vector<int> *nonMeanIndexes)
+/** kMeansAlgorithm::setSeed
+ * @brief Seeds the generator used for k-means++ seeding. If it's not set, the
+ * generator is seeded with rand() on first use.
+ */
+void kMeansAlgorithm::setSeed(unsigned int seed)
 {
-  std::vector<double> weights, probabilities;
-
-  fillMeansWeights(&weights, nonMeanIndexes);
-  fillMeansProbabilities(&weights, &probabilities);
-
-  double r = ((double) rand() / (RAND_MAX));
-  int newMeanIndexPosition = 0;
-
-  //qDebug() << "Getting means position.";
-  while(r > probabilities.at(newMeanIndexPosition))
-  {
-    ++newMeanIndexPosition;
-    if(newMeanIndexPosition == probabilities.size() - 1)
-      break;
-  }
-
-  //qDebug() << "Adding to means vector.";
-  addNewMeanToMeansVector(nonMeanIndexes->at(newMeanIndexPosition));
-  //qDebug() << "Erasing from nonmean indexes.";
-  nonMeanIndexes->erase(nonMeanIndexes->begin() + newMeanIndexPosition);
-
-  return 0;
-}
-
-int kMeansAlgorithm::fillMeansWeights(std::vector<double> *weights,
-                                      std::vector<int> *nonMeansIndexes)
-{
-  double weight;
-
-  weights->clear();
-
-  for(int nonMedoidIndex : *nonMeansIndexes)
-  {
-    weight = 0;
-
-    for(std::shared_ptr<cluster> mean : means)
-      weight += clusDistanceMeasure->countClustersDistance(
-        mean.get(),
-        clusters.at(nonMedoidIndex).get());
-
-    weight /= means.size();
-    weights->push_back(weight);
-  }
-
-  return weights->size();
-}
-
-int kMeansAlgorithm::fillMeansProbabilities(std::vector<double> *weights,
-                                            std::vector<double> *probabilities)
-{
-  probabilities->clear();
-
-  double weightsSum = 0;
-
-  for(double weight : *weights) weightsSum += weight;
-
-  probabilities->push_back(weights->at(0) / weightsSum);
-
-  double probability;
-
-  for(unsigned int i = 1; i < weights->size(); ++i)
-  {
-    probability = probabilities->at(i - 1);
-    probability += weights->at(i) / weightsSum;
-    probabilities->push_back(probability);
-  }
-
-  return probabilities->size();
+  randomNumberGenerator.seed(seed);
+  isRandomNumberGeneratorSeeded = true;
 }
 
 int kMeansAlgorithm::applyNewMeans(
@@ -388,18 +509,18 @@ int kMeansAlgorithm::assignClustersToMeans(
   double minMeanDistance = 1.0;
   int closestMeanIndex = 0;
 
-  for(std::shared_ptr<cluster> c : clusters)
+  // New means are applied, so the cached distances refer to the old ones.
+  distancesCache.invalidate();
+  assignments.assign(clusters.size(), 0);
+
+  for(int i = 0; i < clusters.size(); ++i)
   {
-    minMeanDistance =
-      clusDistanceMeasure->countClustersDistance(target->at(0).get(),
-                                                 c.get());
+    minMeanDistance = getDistanceToMean(target, i, 0);
     closestMeanIndex = 0;
 
     for(int meanIndex = 1; meanIndex < target->size(); ++meanIndex)
     {
-      currentMeanDistance =
-        clusDistanceMeasure->countClustersDistance(target->at(meanIndex).get(),
-                                                   c.get());
+      currentMeanDistance = getDistanceToMean(target, i, meanIndex);
 
       if(currentMeanDistance < minMeanDistance)
       {
@@ -408,8 +529,30 @@ int kMeansAlgorithm::assignClustersToMeans(
       }
     }
 
-    target->at(closestMeanIndex)->addSubcluster(c);
+    assignments[i] = closestMeanIndex;
+    target->at(closestMeanIndex)->addSubcluster(clusters[i]);
   }
+
+  return target->size();
+}
+
+/** kMeansAlgorithm::getDistanceToMean
+ * @brief Returns distance between the cluster and the mean from the target,
+ * counting it only if it's not cached for current means.
+ */
+double kMeansAlgorithm::getDistanceToMean(std::vector<std::shared_ptr<cluster> > *target,
+                                          int clusterIndex, int meanIndex)
+{
+  double distance = 0.0;
+
+  if(distancesCache.getDistance(clusterIndex, clusters.size() + meanIndex, &distance))
+    return distance;
+
+  distance = clusDistanceMeasure->countClustersDistance(target->at(meanIndex).get(),
+                                                        clusters[clusterIndex].get());
+  distancesCache.setDistance(clusterIndex, clusters.size() + meanIndex, distance);
+
+  return distance;
 }
 
 double kMeansAlgorithm::countAssigmentError(
@@ -417,16 +560,9 @@ double kMeansAlgorithm::countAssigmentError(
 {
   double error = 0.0;
 
-  std::vector<std::shared_ptr<cluster>> subclusters;
-
-  for(std::shared_ptr<cluster> c : *target)
-  {
-    c->getSubclusters(&subclusters);
-
-    for(std::shared_ptr<cluster> subcluster : subclusters)
-      error +=
-        clusDistanceMeasure->countClustersDistance(subcluster.get(), c.get());
-  }
+  // Distances to assigned means were just counted during the assignment.
+  for(int i = 0; i < clusters.size(); ++i)
+    error += getDistanceToMean(target, i, assignments[i]);
 
   return error;
 }
@@ -5,8 +5,9 @@
 #include "./kMedoidsAlgorithm/groupingAlgorithm/distanceBasedGroupingAlgorithm.h"
 #include "./kMedoidsAlgorithm/objectsDistanceMeasure.h"
 #include "./kMedoidsAlgorithm/clustersDistanceMeasure.h"
+#include "clusterPairDistanceCache.h"
 
-#include <unordered_map>
+#include <random>
 #include "./kMedoidsAlgorithm/dataParser.h"
 
 
@@ -40,10 +41,18 @@ class kMeansAlgorithm : public distanceBasedGroupingAlgorithm
     void generateClusteringFromMedoids(std::vector<std::shared_ptr<sample> > *objects,
                                        std::vector<std::shared_ptr<cluster>>* target);
 
+    void setNumericalGrouping(bool isEnabled);
+    void setSeed(unsigned int seed);
+
   protected:
 
     unsigned int  numberOfClusters = 1;
     int           initialMeansFindingStrategy = RANDOM;
+    bool          isNumericalGroupingEnabled = false;
+    double        errorThreshold = 1.0e-5;
+
+    std::mt19937  randomNumberGenerator;
+    bool          isRandomNumberGeneratorSeeded = false;
 
     time_t countStart;
 
@@ -52,25 +61,28 @@ class kMeansAlgorithm : public distanceBasedGroupingAlgorithm
     std::vector<std::shared_ptr<cluster>> clusters;
     std::vector<std::shared_ptr<cluster>> means;
 
-    std::unordered_map<std::string, double> similarityData;
+    // Distances between clusters and means, keyed by cluster's index and
+    // clusters.size() + mean's index. Valid until the means move.
+    clusterPairDistanceCache distancesCache;
+    std::vector<int> assignments;
 
     bool canGroupingBePerformed(unsigned int samplesSize);
     void clusterObjects(std::vector<std::shared_ptr<sample>> *objects);
     int performGrouping(std::vector<std::shared_ptr<cluster>>* target);
+    bool performNumericalGrouping(std::vector<std::shared_ptr<cluster>>* target);
+      bool getNumericalValues(std::shared_ptr<sample> object,
+                              std::vector<std::string> *attributesOrder,
+                              std::vector<double> *values);
       int findInitialMeans();
         int getMeansFromFirstMClusters();
         int getMeansFromNewestClusters();
         int findRandomMeans();
         int findMeansAccordingToDistance();
           int addNewMeanToMeansVector(int meanIndex);
-          int addNewMedoidAccordingToDistanceToMeansVector(
-            std::vector<int>* nonMeanIndexes);
-            int fillMeansWeights(std::vector<double> *weights,
-                                 std::vector<int> *nonMeansIndexes);
-            int fillMeansProbabilities(std::vector<double> *weights,
-                                       std::vector<double> *probabilities);
       int applyNewMeans(std::vector<std::shared_ptr<cluster> > *target);
       int assignClustersToMeans(std::vector<std::shared_ptr<cluster> > *target);
+        double getDistanceToMean(std::vector<std::shared_ptr<cluster> > *target,
+                                 int clusterIndex, int meanIndex);
       double countAssigmentError(std::vector<std::shared_ptr<cluster> > *target);
       int findNewMeans(std::vector<std::shared_ptr<cluster> > *target);
         int getAttributesKeysFromObjects(std::vector<std::string> *keys,
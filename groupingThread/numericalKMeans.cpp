@@ -0,0 +1,363 @@
+#include "numericalKMeans.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../Libraries/threadPool.h"
+
+// Chunks are small enough to balance the load on the pool and large enough for
+// their accumulators to be cheap to merge.
+static const int MIN_POINTS_PER_CHUNK = 512;
+static const int MAX_CHUNKS_NUMBER = 64;
+
+numericalKMeans::numericalKMeans(int dimension)
+{
+  this->dimension = dimension > 0 ? dimension : 1;
+}
+
+/** numericalKMeans::setPoints
+ * @brief Sets points to group.
+ * @param points - Row-major matrix of points, dimension values per point.
+ * @param weights - Weights of the points in the means, one per point.
+ * @return Number of points.
+ */
+int numericalKMeans::setPoints(const std::vector<double> &points, const std::vector<double> &weights)
+{
+  this->points = points;
+  this->weights = weights;
+  pointsNumber = points.size() / dimension;
+  this->weights.resize(pointsNumber, 1.0);
+  assignments.assign(pointsNumber, 0);
+  lowerBounds.assign(pointsNumber, 0.0);
+  areBoundsValid = false;
+  prepareChunks();
+
+  return pointsNumber;
+}
+
+/** numericalKMeans::setMeans
+ * @brief Sets initial means.
+ * @param means - Row-major matrix of means, dimension values per mean.
+ * @return Number of means.
+ */
+int numericalKMeans::setMeans(const std::vector<double> &means)
+{
+  meansNumber = means.size() / dimension;
+  meansT.assign(meansNumber * dimension, 0.0);
+
+  for(int c = 0; c < meansNumber; ++c)
+  {
+    for(int a = 0; a < dimension; ++a)
+      meansT[a * meansNumber + c] = means[c * dimension + a];
+  }
+
+  newMeansT.assign(meansT.size(), 0.0);
+  meansWeights.assign(meansNumber, 0.0);
+  halvesOfMeansDistances.assign(meansNumber, 0.0);
+  areBoundsValid = false;
+  prepareChunks();
+
+  return meansNumber;
+}
+
+/** numericalKMeans::group
+ * @brief Performs Lloyd's iterations until error decreases by no more than
+ * errorThreshold.
+ * @return Number of performed iterations.
+ */
+int numericalKMeans::group(double errorThreshold)
+{
+  if(pointsNumber == 0 || meansNumber == 0) return 0;
+
+  double oldError = 0.0;
+  double newError = std::numeric_limits<double>::max();
+  int iterationsNumber = 0;
+
+  do
+  {
+    if(iterationsNumber > 0)
+    {
+      meansT.swap(newMeansT);
+      updateBounds(newMeansT);
+    }
+
+    oldError = newError;
+    newError = assignPointsToMeans();
+    findNewMeans();
+    ++iterationsNumber;
+  } while(oldError - newError > errorThreshold);
+
+  error = newError;
+
+  return iterationsNumber;
+}
+
+const std::vector<int> &numericalKMeans::getAssignments()
+{
+  return assignments;
+}
+
+/** numericalKMeans::getMeans
+ * @brief Returns means that the points are assigned to, as row-major matrix.
+ */
+std::vector<double> numericalKMeans::getMeans()
+{
+  std::vector<double> means(meansNumber * dimension, 0.0);
+
+  for(int c = 0; c < meansNumber; ++c)
+  {
+    for(int a = 0; a < dimension; ++a)
+      means[c * dimension + a] = meansT[a * meansNumber + c];
+  }
+
+  return means;
+}
+
+double numericalKMeans::getError()
+{
+  return error;
+}
+
+/** numericalKMeans::prepareChunks
+ * @brief Splits the points into chunks and allocates their accumulators.
+ */
+void numericalKMeans::prepareChunks()
+{
+  chunksNumber = std::max(1, std::min(MAX_CHUNKS_NUMBER, pointsNumber / MIN_POINTS_PER_CHUNK));
+  chunksErrors.assign(chunksNumber, 0.0);
+  chunksMeansSumsT.assign(chunksNumber * meansNumber * dimension, 0.0);
+  chunksMeansWeights.assign(chunksNumber * meansNumber, 0.0);
+  chunksDistances.assign(chunksNumber * meansNumber, 0.0);
+}
+
+/** numericalKMeans::assignPointsToMeans
+ * @brief Assigns the points to the closest means, chunks in parallel. Sums of
+ * the new means are accumulated along the way.
+ * @return Sum of distances of the points to their means.
+ */
+double numericalKMeans::assignPointsToMeans()
+{
+  ThreadPool::Instance().ParallelFor(0, chunksNumber, [&](const size_t &chunkBegin, const size_t &chunkEnd) {
+    for(size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+      assignChunkToMeans(chunk);
+  }, chunksNumber);
+
+  areBoundsValid = true;
+
+  double assignmentError = 0.0;
+
+  for(int chunk = 0; chunk < chunksNumber; ++chunk)
+    assignmentError += chunksErrors[chunk];
+
+  return assignmentError;
+}
+
+/** numericalKMeans::assignChunkToMeans
+ * @brief Assigns points of the chunk to the closest means and accumulates the
+ * chunk's error, sums and weights of the new means. Only chunk's own data is
+ * written, so chunks can be processed concurrently.
+ */
+void numericalKMeans::assignChunkToMeans(int chunkIndex)
+{
+  const int begin = (long long)chunkIndex * pointsNumber / chunksNumber;
+  const int end = (long long)(chunkIndex + 1) * pointsNumber / chunksNumber;
+  const int k = meansNumber;
+  double *sumsT = &chunksMeansSumsT[chunkIndex * k * dimension];
+  double *sumsWeights = &chunksMeansWeights[chunkIndex * k];
+  double *d = &chunksDistances[chunkIndex * k];
+  double chunkError = 0.0;
+
+  std::fill(sumsT, sumsT + k * dimension, 0.0);
+  std::fill(sumsWeights, sumsWeights + k, 0.0);
+
+  for(int i = begin; i < end; ++i)
+  {
+    bool isAssignmentKept = false;
+
+    if(areBoundsValid)
+    {
+      // Bounds are compared with a small margin, so that rounding can't make a
+      // point skip a mean that is in fact as close as the assigned one.
+      int a = assignments[i];
+      double distance = getDistanceToMean(i, a);
+      double bound = std::max(halvesOfMeansDistances[a], lowerBounds[i]);
+
+      if(distance * (1.0 + 1e-9) < bound)
+      {
+        chunkError += distance;
+        isAssignmentKept = true;
+      }
+    }
+
+    if(!isAssignmentKept) chunkError += assignPointToClosestMean(i, d);
+
+    const int c = assignments[i];
+    const double w = weights[i];
+    sumsWeights[c] += w;
+
+    for(int a = 0; a < dimension; ++a)
+      sumsT[a * k + c] += w * points[i * dimension + a];
+  }
+
+  chunksErrors[chunkIndex] = chunkError;
+}
+
+/** numericalKMeans::assignPointToClosestMean
+ * @brief Counts distances from the point to all the means, assigns it to the
+ * closest one and updates its lower bound.
+ * @param distances - Buffer for the squared distances, one per mean.
+ * @return Distance to the closest mean.
+ */
+double numericalKMeans::assignPointToClosestMean(int pointIndex, double *distances)
+{
+  double *d = distances;
+  const double *m = meansT.data();
+  const double *x = &points[pointIndex * dimension];
+  const int k = meansNumber;
+
+  for(int c = 0; c < k; ++c) d[c] = 0.0;
+
+  for(int a = 0; a < dimension; ++a)
+  {
+    const double xa = x[a];
+    const double *ma = m + a * k;
+
+    for(int c = 0; c < k; ++c)
+    {
+      double difference = xa - ma[c];
+      d[c] += difference * difference;
+    }
+  }
+
+  int closestMeanIndex = 0;
+  double secondSmallestDistance = std::numeric_limits<double>::max();
+
+  for(int c = 1; c < k; ++c)
+  {
+    if(d[c] < d[closestMeanIndex])
+    {
+      secondSmallestDistance = d[closestMeanIndex];
+      closestMeanIndex = c;
+    }
+    else if(d[c] < secondSmallestDistance)
+    {
+      secondSmallestDistance = d[c];
+    }
+  }
+
+  assignments[pointIndex] = closestMeanIndex;
+  lowerBounds[pointIndex] = std::sqrt(secondSmallestDistance);
+
+  return std::sqrt(d[closestMeanIndex]);
+}
+
+double numericalKMeans::getDistanceToMean(int pointIndex, int meanIndex)
+{
+  // Same order of operations as in assignPointToClosestMean, so the distance is
+  // exactly the same.
+  const double *x = &points[pointIndex * dimension];
+  double squaredDistance = 0.0;
+
+  for(int a = 0; a < dimension; ++a)
+  {
+    double difference = x[a] - meansT[a * meansNumber + meanIndex];
+    squaredDistance += difference * difference;
+  }
+
+  return std::sqrt(squaredDistance);
+}
+
+/** numericalKMeans::updateBounds
+ * @brief Decreases lower bounds by the largest movement of the other means and
+ * counts halves of distances between the means.
+ */
+void numericalKMeans::updateBounds(const std::vector<double> &oldMeansT)
+{
+  std::vector<double> movements(meansNumber, 0.0);
+  int mostMovedMeanIndex = 0;
+  double largestMovement = 0.0, secondLargestMovement = 0.0;
+
+  for(int c = 0; c < meansNumber; ++c)
+  {
+    for(int a = 0; a < dimension; ++a)
+    {
+      double difference = meansT[a * meansNumber + c] - oldMeansT[a * meansNumber + c];
+      movements[c] += difference * difference;
+    }
+
+    movements[c] = std::sqrt(movements[c]);
+
+    if(movements[c] > largestMovement)
+    {
+      secondLargestMovement = largestMovement;
+      largestMovement = movements[c];
+      mostMovedMeanIndex = c;
+    }
+    else if(movements[c] > secondLargestMovement)
+    {
+      secondLargestMovement = movements[c];
+    }
+  }
+
+  ThreadPool::Instance().ParallelFor(0, pointsNumber, [&](const size_t &chunkBegin, const size_t &chunkEnd) {
+    for(size_t i = chunkBegin; i < chunkEnd; ++i)
+      lowerBounds[i] -= assignments[i] == mostMovedMeanIndex ? secondLargestMovement : largestMovement;
+  }, chunksNumber);
+
+  for(int c = 0; c < meansNumber; ++c)
+  {
+    double smallestDistance = std::numeric_limits<double>::max();
+
+    for(int otherC = 0; otherC < meansNumber; ++otherC)
+    {
+      if(otherC == c) continue;
+
+      double squaredDistance = 0.0;
+
+      for(int a = 0; a < dimension; ++a)
+      {
+        double difference = meansT[a * meansNumber + c] - meansT[a * meansNumber + otherC];
+        squaredDistance += difference * difference;
+      }
+
+      smallestDistance = std::min(smallestDistance, squaredDistance);
+    }
+
+    halvesOfMeansDistances[c] = 0.5 * std::sqrt(smallestDistance);
+  }
+}
+
+/** numericalKMeans::findNewMeans
+ * @brief Merges sums accumulated by the chunks, in chunk order, and counts
+ * weighted means of the assigned points into newMeansT. Means without
+ * (weighted) points stay where they were.
+ */
+void numericalKMeans::findNewMeans()
+{
+  std::fill(newMeansT.begin(), newMeansT.end(), 0.0);
+  std::fill(meansWeights.begin(), meansWeights.end(), 0.0);
+
+  const size_t sumsSize = newMeansT.size();
+
+  for(int chunk = 0; chunk < chunksNumber; ++chunk)
+  {
+    const double *sumsT = &chunksMeansSumsT[chunk * sumsSize];
+    const double *sumsWeights = &chunksMeansWeights[chunk * meansNumber];
+
+    for(size_t j = 0; j < sumsSize; ++j)
+      newMeansT[j] += sumsT[j];
+
+    for(int c = 0; c < meansNumber; ++c)
+      meansWeights[c] += sumsWeights[c];
+  }
+
+  for(int c = 0; c < meansNumber; ++c)
+  {
+    for(int a = 0; a < dimension; ++a)
+    {
+      if(meansWeights[c] > 0) newMeansT[a * meansNumber + c] /= meansWeights[c];
+      else newMeansT[a * meansNumber + c] = meansT[a * meansNumber + c];
+    }
+  }
+}
@@ -0,0 +1,77 @@
+#ifndef NUMERICALKMEANS_H
+#define NUMERICALKMEANS_H
+
+#include <vector>
+
+/** Lloyd's k-means over numerical points, stored contiguously in a row-major
+ * matrix. Means are kept transposed (one row per attribute), so that distances
+ * from a point to all the means are counted in loops over contiguous memory,
+ * which compiler vectorizes. Distance is Euclidean.
+ *
+ * Assignment is accelerated with Hamerly's bounds. For each point, lower bound
+ * of the distance to its second closest mean is kept and decreased by the
+ * largest movement of the means. If the exact distance to the assigned mean is
+ * below that bound and half the distance to the mean's closest mean, the point
+ * can't change its mean and other distances are skipped. Assignments are the
+ * same as without the bounds.
+ *
+ * Iterations follow kMeansAlgorithm: points are assigned to the means, error
+ * (sum of distances to assigned means) is counted and new (weighted) means are
+ * found, until error decreases by no more than the threshold. Returned means
+ * are the ones that the points are assigned to.
+ *
+ * Points are split into chunks, which are assigned in parallel on the thread
+ * pool. Each chunk accumulates its own error and sums of the new means, which
+ * are then merged in chunk order. Number of chunks depends only on number of
+ * points, so results don't depend on number of threads or their timing.
+ */
+class numericalKMeans
+{
+  public:
+
+    numericalKMeans(int dimension);
+
+    int setPoints(const std::vector<double> &points, const std::vector<double> &weights);
+    int setMeans(const std::vector<double> &means);
+    int group(double errorThreshold);
+
+    const std::vector<int> &getAssignments();
+    std::vector<double> getMeans();
+    double getError();
+
+  protected:
+
+    int dimension = 1;
+    int pointsNumber = 0;
+    int meansNumber = 0;
+
+    std::vector<double> points;
+    std::vector<double> weights;
+    std::vector<double> meansT;    // Means, transposed: meansT[a * meansNumber + c].
+    std::vector<double> newMeansT;
+    std::vector<double> meansWeights;
+    std::vector<int> assignments;
+    double error = 0.0;
+
+    // Hamerly's bounds.
+    bool areBoundsValid = false;
+    std::vector<double> lowerBounds;            // Of distances to second closest means.
+    std::vector<double> halvesOfMeansDistances; // Halves of distances to closest other means.
+
+    // Chunks of points, processed in parallel.
+    int chunksNumber = 1;
+    std::vector<double> chunksErrors;
+    std::vector<double> chunksMeansSumsT;   // Chunk after chunk, laid out as meansT.
+    std::vector<double> chunksMeansWeights;
+    std::vector<double> chunksDistances;    // Squared distances from current point of the chunk to the means.
+
+    void prepareChunks();
+    double assignPointsToMeans();
+    void assignChunkToMeans(int chunkIndex);
+    double assignPointToClosestMean(int pointIndex, double *distances);
+    double getDistanceToMean(int pointIndex, int meanIndex);
+    void updateBounds(const std::vector<double> &oldMeansT);
+    void findNewMeans();
+};
+
+#endif // NUMERICALKMEANS_H
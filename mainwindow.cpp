@@ -7,6 +7,7 @@
 #include <chrono>
 #include <QDateTime>
 #include <Benchmarking/errorsCalculator.h>
+#include <Benchmarking/stepProfiler.h>
 #include <UI/plotLabelDoubleDataPreparator.h>
 
 #include "kerDepCcWde.h"
@@ -41,8 +42,11 @@
 #include <QDate>
 #include <QTime>
 #include <QtGlobal>
+#include <QEventLoop>
+#include <QTimer>
 
 #include "UI/QwtContourPlotUI.h"
+#include "UI/estimatorWorker.h"
 
 ClusterKernel *CreateNewVarianceBasedClusterKernel(ClusterKernelStreamElement *stream_element) {
   auto newClusterKernel = new VarianceBasedClusterKernel(stream_element);
@@ -75,6 +79,9 @@ MainWindow::MainWindow(QWidget *parent) :
 
   ui->setupUi(this);
 
+  frame_export_pipeline_.reset(new FrameExportPipeline());
+  plot_curves_.reset(new PlotCurvesModel(ui->widget_plot));
+
   // Adding contour plot
   contour_plot_ = new Plot(ui->widget_contour_plot);
   auto l = new QGridLayout(ui->widget_contour_plot);
@@ -160,178 +167,136 @@ void MainWindow::SetupKernelsTable() {
   RefreshTargetFunctionTable();
 }
 
-void MainWindow::DrawPlots(DESDA *DESDAAlgorithm) {
-  ClearPlot();
+/** Draws the curves of the snapshot, along with the marks of the atypical elements. Curves are computed by the
+ * worker, only the ones which check boxes are checked are drawn.
+ * @brief Draws the curves of the snapshot.
+ */
+void MainWindow::DrawPlots(const EstimatorSnapshot &snapshot) {
+  plot_curves_->BeginFrame();
+  RemoveUncommonClustersMarks();
   ResizePlot();
 
-  int replace_constant = 0;
-
-  std::vector<std::vector<double>> drawable_domain = {}; // This is required for types :P
-  for(auto value : drawable_domain_) {
-    drawable_domain.push_back({value});
-  }
-
-  // Generate plot of model function
-  if(ui->checkBox_showEstimatedPlot->isChecked()) {
-    auto target_function_values = GetFunctionsValueOnDomain(target_function_.get(), drawable_domain);
-    auto modelDistributionY = QVector<qreal>(target_function_values.begin(), target_function_values.end());
-    AddPlot(&modelDistributionY, model_plot_pen_);
-  }
+  const std::unordered_map<std::string, QPen> curves_pens = {
+      {"model", model_plot_pen_}, {"windowed_kde", windowed_plot_pen_}, {"kde", kde_plot_pen_},
+      {"weighted_kde", weighted_plot_pen_}, {"enhanced_kde", desda_kde_plot_pen_},
+      {"rare_elements_kde", desda_rare_elements_kde_plot_pen_}, {"derivative", derivative_plot_pen_}
+  };
+  auto curves_check_boxes = GetCurvesCheckBoxes();
 
-  // Generate m=m0 estimator plot
-  if(ui->checbox_showFullEstimator->isChecked()) {
-    auto windowed_estimator_values = DESDAAlgorithm->getWindowKDEValues(&drawable_domain);
-    auto windowed_estimator_y = QVector<double>(windowed_estimator_values.begin(),
-                                                windowed_estimator_values.end());
+  for(size_t i = 0; i < snapshot.curves_names_.size(); ++i) {
+    const auto &name = snapshot.curves_names_[i];
 
-    for(auto i = 0; i < drawable_domain_.size(); ++i){
-      drawable_domain_[i] += replace_constant;
-    }
+    if(curves_pens.count(name) == 0 || !curves_check_boxes[name]->isChecked()) continue;
 
-    AddPlot(&windowed_estimator_y, windowed_plot_pen_);
+    AddPlot(name, snapshot.curves_values_[i], curves_pens.at(name));
   }
 
-  // Generate variable m estimator plot
-  if(ui->checkBox_showEstimationPlot->isChecked()) {
-    auto less_elements_estimator_values = DESDAAlgorithm->getKDEValues(&drawable_domain);
-    auto less_elements_estimator_y = QVector<double>(less_elements_estimator_values.begin(),
-                                                     less_elements_estimator_values.end());
+  // Generate plot for standardized prognosis derivative
+  auto derivative_name = std::find(snapshot.curves_names_.begin(), snapshot.curves_names_.end(), "derivative");
 
-    for(auto i = 0; i < drawable_domain_.size(); ++i){
-      drawable_domain_[i] += replace_constant;
-    }
+  if(ui->checkBox_standarizedDerivative->isChecked() && derivative_name != snapshot.curves_names_.end()) {
+    const auto &derivative_values = snapshot.curves_values_[derivative_name - snapshot.curves_names_.begin()];
+    std::vector<double> standardizedDerivativeY = {};
 
-    AddPlot(&less_elements_estimator_y, kde_plot_pen_);
-  }
-
-  // Generate weights estimator plot
-  if(ui->checkBox_showWeightedEstimationPlot->isChecked()) {
-    auto weighted_estimator_values = DESDAAlgorithm->getWeightedKDEValues(&drawable_domain);
-    auto weighted_estimator_y = QVector<double>(weighted_estimator_values.begin(),
-                                                weighted_estimator_values.end());
+    double normalization_factor = 0;
 
-    for(auto i = 0; i < drawable_domain_.size(); ++i){
-      drawable_domain_[i] += replace_constant;
+    for(auto val : derivative_values) {
+      normalization_factor = std::max(normalization_factor, qAbs(val));
     }
 
-    AddPlot(&weighted_estimator_y, weighted_plot_pen_);
-  }
-
-  // Generate plot for prognosis estimator
-  if(ui->checkBox_sigmoidallyEnhancedKDE->isChecked()) {
-    auto prognosis_enhanced_plot_values = DESDAAlgorithm->getEnhancedKDEValues(&drawable_domain);
-    auto prognosis_enhanced_plot_y = QVector<double>(prognosis_enhanced_plot_values.begin(),
-                                                     prognosis_enhanced_plot_values.end());
-
-    for(auto i = 0; i < drawable_domain_.size(); ++i){
-      drawable_domain_[i] += replace_constant;
-    }
-
-    AddPlot(&prognosis_enhanced_plot_y, desda_kde_plot_pen_);
-  }
-
-  // Generate plot for atypical estimator
-  if(ui->checkBox_REESEKDE->isChecked()) {
-    auto rare_elements_enhanced_plot_values = DESDAAlgorithm->getRareElementsEnhancedKDEValues(&drawable_domain);
-    auto rare_elements_enhanced_plot_y = QVector<double>(rare_elements_enhanced_plot_values.begin(),
-                                                         rare_elements_enhanced_plot_values.end());
-
-    for(auto i = 0; i < drawable_domain_.size(); ++i){
-      drawable_domain_[i] += replace_constant;
+    for(auto val : derivative_values) {
+      standardizedDerivativeY.push_back( 0.1 * val / normalization_factor);
     }
-
-    AddPlot(&rare_elements_enhanced_plot_y, desda_rare_elements_kde_plot_pen_);
+    AddPlot("standardized_derivative", standardizedDerivativeY, standardized_derivative_plot_pen_);
   }
 
-  // Generate prognosis derivative plot
-  if(ui->checkBox_kernelPrognosedPlot->isChecked()) {
-    AddPlot(&kernel_prognosis_derivative_values_, derivative_plot_pen_);
+  if(ui->checkBox_showUnusualClusters->isChecked()) {
+    atypical_elements_values_and_derivatives_ = QVector<std::pair<double, double>>(
+        snapshot.atypical_elements_values_and_derivatives_.begin(),
+        snapshot.atypical_elements_values_and_derivatives_.end());
+    quantile_estimator_value_ = snapshot.quantile_estimator_value_;
+    MarkUncommonClusters();
   }
 
-  // Generate plot for standardized prognosis derivative, assuming that normal derivative was generated first
-  if(ui->checkBox_standarizedDerivative->isChecked()) {
-    QVector<double> standardizedDerivativeY = {};
+  plot_curves_->EndFrame();
+}
 
-    double normalization_factor = qAbs(kernel_prognosis_derivative_values_[0]);
+std::unordered_map<std::string, QCheckBox *> MainWindow::GetCurvesCheckBoxes() {
+  return {
+      {"model", ui->checkBox_showEstimatedPlot}, {"windowed_kde", ui->checbox_showFullEstimator},
+      {"kde", ui->checkBox_showEstimationPlot}, {"weighted_kde", ui->checkBox_showWeightedEstimationPlot},
+      {"enhanced_kde", ui->checkBox_sigmoidallyEnhancedKDE}, {"rare_elements_kde", ui->checkBox_REESEKDE},
+      {"derivative", ui->checkBox_kernelPrognosedPlot}
+  };
+}
 
-    for(auto val : kernel_prognosis_derivative_values_) {
-      if(qAbs(val) > normalization_factor){
-        normalization_factor = qAbs(val);
-      }
-    }
+/** Gets names of the curves that are shown when the experiment starts, so that the worker computes only them.
+ * Curves checked later on won't appear until the next experiment.
+ * @brief Gets names of the curves that are shown.
+ */
+std::unordered_set<std::string> MainWindow::GetShownCurvesNames() {
+  std::unordered_set<std::string> shown_curves_names = {};
 
-    for(auto val : kernel_prognosis_derivative_values_) {
-      standardizedDerivativeY.push_back( 0.1 * val / normalization_factor);
-    }
-    AddPlot(&standardizedDerivativeY, standardized_derivative_plot_pen_);
+  for(const auto &check_box : GetCurvesCheckBoxes()) {
+    if(check_box.second->isChecked()) shown_curves_names.insert(check_box.first);
   }
 
-  if(ui->checkBox_showUnusualClusters->isChecked()) {
-    atypical_elements_values_and_derivatives_ =
-        DESDAAlgorithm->getAtypicalElementsValuesAndDerivatives();
-    quantile_estimator_value_ = DESDAAlgorithm->_quantileEstimator;
-    MarkUncommonClusters();
-  }
+  // Standardized derivative is computed from the derivative.
+  if(ui->checkBox_standarizedDerivative->isChecked()) shown_curves_names.insert("derivative");
 
-  // Draw plots
-  ui->widget_plot->replot();
+  return shown_curves_names;
 }
 
-void MainWindow::DrawPlots(EnhancedClusterKernelAlgorithm *CKAlgorithm) {
-  ClearPlot();
-  ResizePlot();
-
+std::vector<std::vector<double>> MainWindow::GetDrawableDomainPoints() {
   std::vector<std::vector<double>> drawable_domain = {}; // This is required for types :P
+
   for(auto value : drawable_domain_) {
     drawable_domain.push_back({value});
   }
 
-  // Generate plot of model function
-  if(ui->checkBox_showEstimatedPlot->isChecked()) {
-    auto model_distribution_values = GetFunctionsValueOnDomain(target_function_.get(), drawable_domain);
-    QVector<qreal> modelDistributionY = QVector<qreal>(model_distribution_values.begin(),
-                                                       model_distribution_values.end());
-    AddPlot(&modelDistributionY, model_plot_pen_);
-  }
+  return drawable_domain;
+}
 
-  // Generate less elements KDE plot (navy blue)
-  if(ui->checkBox_showEstimationPlot->isChecked()) {
-    auto less_elements_estimator_values = CKAlgorithm->GetKDEValuesOnDomain(drawable_domain);
-    auto less_elements_estimator_y = QVector<double>(less_elements_estimator_values.begin(),
-                                                     less_elements_estimator_values.end());
-    AddPlot(&less_elements_estimator_y, kde_plot_pen_);
-  }
+/** Computes the curve of DESDA with given name on the domain. Derivative is the one computed last on the drawable
+ * domain.
+ * @brief Computes the curve of DESDA with given name on the domain.
+ */
+std::vector<double> MainWindow::GetCurveValues(DESDA *DESDAAlgorithm, const std::string &name,
+                                               const std::vector<std::vector<double>> *domain) {
+  if(name == "model") return target_function_->getValues(*domain);
+  if(name == "windowed_kde") return DESDAAlgorithm->getWindowKDEValues(domain);
+  if(name == "kde") return DESDAAlgorithm->getKDEValues(domain);
+  if(name == "weighted_kde") return DESDAAlgorithm->getWeightedKDEValues(domain);
+  if(name == "enhanced_kde") return DESDAAlgorithm->getEnhancedKDEValues(domain);
+  if(name == "rare_elements_kde") return DESDAAlgorithm->getRareElementsEnhancedKDEValues(domain);
+  if(name == "derivative") {
+    return std::vector<double>(kernel_prognosis_derivative_values_.begin(), kernel_prognosis_derivative_values_.end());
+  }
+
+  log("Unknown curve: " + QString::fromStdString(name));
+  return {};
 }
 
-void MainWindow::DrawPlots(KerDEP_CC_WDE *WDEAlgorithm) {
-  ClearPlot();
-  ResizePlot();
+/** Computes all the curves of DESDA on the drawable domain, regardless of which are shown on the plot. Scalars are
+ * left for the caller.
+ * @brief Computes all the curves of DESDA on the drawable domain.
+ */
+CurveDumpFrame MainWindow::GenerateCurveDumpFrame(DESDA *DESDAAlgorithm) {
+  CurveDumpFrame frame;
+  frame.step_number_ = step_number_;
+  frame.domain_ = std::vector<double>(drawable_domain_.begin(), drawable_domain_.end());
 
-  std::vector<std::vector<double>> drawable_domain = {}; // This is required for types :P
-  for(auto value : drawable_domain_) {
-    drawable_domain.push_back({value});
-  }
+  auto drawable_domain = GetDrawableDomainPoints();
 
-  // Generate plot of model function
-  if(ui->checkBox_showEstimatedPlot->isChecked()) {
-    auto model_distribution_values = GetFunctionsValueOnDomain(target_function_.get(), drawable_domain);
-    QVector<qreal> modelDistributionY = QVector<qreal>(model_distribution_values.begin(),
-                                                       model_distribution_values.end());
-    AddPlot(&modelDistributionY, model_plot_pen_);
+  for(const auto &name : desda_dump_curves_names_) {
+    frame.curves_.push_back(GetCurveValues(DESDAAlgorithm, name, &drawable_domain));
   }
 
-  // Generate less elements KDE plot (navy blue)
-  if(ui->checkBox_showEstimationPlot->isChecked()) {
-    auto estimator_values = WDEAlgorithm->GetEstimatorValuesOnDomain(drawable_domain);
-    auto estimator_y = QVector<double>(estimator_values.begin(), estimator_values.end());
-    AddPlot(&estimator_y, kde_plot_pen_);
-  }
+  return frame;
 }
 
-void MainWindow::AddPlot(const QVector<qreal> *Y, const QPen &pen) {
-  ui->widget_plot->addGraph();
-  ui->widget_plot->graph(ui->widget_plot->graphCount() - 1)->setData(drawable_domain_, *Y);
-  ui->widget_plot->graph(ui->widget_plot->graphCount() - 1)->setPen(pen);
+void MainWindow::AddPlot(const std::string &name, const std::vector<double> &Y, const QPen &pen) {
+  plot_curves_->SetCurve(name, drawable_domain_, Y, pen);
 }
 
 void MainWindow::ResizePlot() {
@@ -366,6 +331,15 @@ void MainWindow::ResizePlot() {
     maxY = kDefaultMaxY;
   }
 
+  // Ticker is only rebuilt (and plot replotted as a whole) when the ranges change.
+  QVector<double> plot_ranges = {ui->widget_plot->xAxis->range().lower, ui->widget_plot->xAxis->range().upper,
+                                 ui->widget_plot->yAxis->range().lower, ui->widget_plot->yAxis->range().upper};
+
+  if(plot_ranges == plot_ranges_) return;
+
+  plot_ranges_ = plot_ranges;
+  plot_curves_->Invalidate();
+
   ui->widget_plot->xAxis->setTickLabelFont(QFont(font().family(), 14));
   ui->widget_plot->yAxis->setTickLabelFont(QFont(font().family(), 14));
 
@@ -401,14 +375,19 @@ void MainWindow::ResizePlot() {
 }
 
 void MainWindow::ClearPlot() {
-  while(ui->widget_plot->graphCount() != 0)
-    ui->widget_plot->removeGraph(0);
+  plot_curves_->Clear();
+  RemoveUncommonClustersMarks();
+}
+
+void MainWindow::RemoveUncommonClustersMarks() {
+  if(lines_on_plot_.empty()) return;
 
   for(auto a : lines_on_plot_) {
     ui->widget_plot->removeItem(a);
   }
 
   lines_on_plot_.clear();
+  plot_curves_->Invalidate();
 }
 
 unsigned long long MainWindow::MarkUncommonClusters() {
@@ -424,6 +403,8 @@ unsigned long long MainWindow::MarkUncommonClusters() {
     lines_on_plot_.push_back(verticalLine);
   }
 
+  if(!atypical_elements_values_and_derivatives_.empty()) plot_curves_->Invalidate();
+
   return atypical_elements_values_and_derivatives_.size();
 }
 
@@ -607,11 +588,10 @@ kernelDensityEstimator *MainWindow::GenerateKernelDensityEstimator(
                                    );
 }
 
-function *MainWindow::GenerateTargetFunction(
+cachedNormalMixtureDensityFunction *MainWindow::GenerateTargetFunction(
     vector<std::shared_ptr<vector<double>>> *means,
     vector<std::shared_ptr<vector<double>>> *stDevs) {
   vector<double> contributions;
-  vector<std::shared_ptr<function>> elementalFunctions;
   int targetFunctionElementsNumber = ui->tableWidget_targetFunctions
                                        ->rowCount();
 
@@ -636,13 +616,9 @@ function *MainWindow::GenerateTargetFunction(
                                                                    static_cast<int>(TargetFunctionSettingsColumns::kContributionColumnIndex))))
                              ->text().toDouble()
                      );
-
-    elementalFunctions.push_back(
-        std::shared_ptr<function>(new multivariateNormalProbabilityDensityFunction(means->at(functionIndex).get(),
-                                                                                   stDevs->at(functionIndex).get())));
   }
 
-  return new complexFunction(&contributions, &elementalFunctions);
+  return new cachedNormalMixtureDensityFunction(&contributions, means, stDevs);
 }
 
 int MainWindow::CanAnimationBePerformed(int dimensionsNumber) {
@@ -1042,7 +1018,7 @@ void MainWindow::on_pushButton_clicked() {
 
   QString imageName = dirPath + QString::number(0) + ".png";
 
-  log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+  ExportPlotFrame(imageName, 0);
   expNumLabel.setText("");
   // Initial screen generated.
 
@@ -1117,7 +1093,7 @@ void MainWindow::on_pushButton_clicked() {
 
       QString imageName = dirPath + QString::number(step_number_) + ".png";
       log("Image name: " + imageName);
-      log("Saved: " + QString::number(ui->widget_contour_plot_holder->grab().save(imageName)));
+      ExportContourPlotFrame(imageName);
       log("Drawing finished.");
     }
 
@@ -1132,9 +1108,201 @@ void MainWindow::on_pushButton_clicked() {
     log("Step time: " + QString::number(endTime - startTime) + " s");
   }
 
+  frame_export_pipeline_->Flush();
+
   log("Done!");
 }
 
+/** Rasterizes the 1D plot and hands it to the export pipeline. Only rasterization is done in the calling thread,
+ * encoding and writing is done in the background.
+ * @brief Rasterizes the 1D plot and hands it to the export pipeline.
+ * @param image_name - Path of the PNG file.
+ * @param step_number - Step of the experiment shown on the plot.
+ */
+void MainWindow::ExportPlotFrame(const QString &image_name, const int &step_number) {
+  frame_export_pipeline_->Publish(ui->widget_plot->toPixmap(0, 0, 1).toImage(), image_name, step_number);
+  log("Frame queued: " + image_name);
+}
+
+/** Rasterizes the contour plot with its labels and hands it to the export pipeline.
+ * @brief Rasterizes the contour plot and hands it to the export pipeline.
+ * @param image_name - Path of the PNG file.
+ */
+void MainWindow::ExportContourPlotFrame(const QString &image_name) {
+  frame_export_pipeline_->Publish(ui->widget_contour_plot_holder->grab().toImage(), image_name, step_number_);
+  log("Frame queued: " + image_name);
+}
+
+/** Runs the loop of the experiment on the worker thread and renders the snapshots it publishes, until it's
+ * finished. Once per render interval the frames queued since the last one are all rendered and exported, in order,
+ * and then the newest live snapshot is rendered, unless a frame was published after it. Controls that start the
+ * experiments or change the target function are disabled for the whole run, as the loop uses the state of the window.
+ * @brief Runs the loop of the experiment on the worker thread and renders its snapshots.
+ * @param snapshot_buffer - Buffer to which the loop publishes the snapshots.
+ * @param estimator_loop - Loop of the experiment. It shouldn't touch the GUI.
+ * @param render - Renders the frame on the plot.
+ * @param render_live - Updates the plot with the live snapshot, on top of the last rendered frame.
+ */
+void MainWindow::RunEstimatorLoop(EstimatorSnapshotBuffer *snapshot_buffer,
+                                  const std::function<void()> &estimator_loop,
+                                  const std::function<void(const EstimatorSnapshot &)> &render,
+                                  const std::function<void(const EstimatorSnapshot &)> &render_live) {
+  EstimatorWorker worker(estimator_loop);
+  long long rendered_version = 0;
+  bool is_loop_finished = false;
+
+  auto render_published_snapshots = [&]() {
+    for(const auto &frame : snapshot_buffer->TakeFrames()) {
+      render(*frame);
+      ExportPlotFrame(frame->frame_path_, frame->step_number_);
+      rendered_version = frame->version_;
+    }
+
+    auto snapshot = snapshot_buffer->TakeLatest();
+
+    if(snapshot == nullptr || snapshot->version_ < rendered_version) return;
+
+    render_live(*snapshot);
+    rendered_version = snapshot->version_;
+  };
+
+  QEventLoop event_loop;
+  QTimer render_timer;
+  connect(&render_timer, &QTimer::timeout, &event_loop, render_published_snapshots);
+  connect(&worker, &QThread::finished, &event_loop, [&]() {
+    is_loop_finished = true;
+    event_loop.quit();
+  });
+
+  // Experiments share the state of the window, so only one can run at once.
+  SetExperimentControlsEnabled(false);
+
+  render_timer.start(kRenderIntervalMs);
+  worker.start();
+  event_loop.exec();
+  render_timer.stop();
+
+  if(!is_loop_finished) {
+    // Event loop was quit from the outside (e.g. the application is closing), so nothing will render the frames.
+    log("Experiment interrupted.");
+    snapshot_buffer->Close();
+  }
+
+  worker.wait();
+
+  if(is_loop_finished) render_published_snapshots();
+
+  SetExperimentControlsEnabled(true);
+}
+
+/** Enables or disables the controls that start the experiments or change the target function they use.
+ * @brief Enables or disables the controls that start the experiments.
+ * @param enabled - Whether the controls should be enabled.
+ */
+void MainWindow::SetExperimentControlsEnabled(const bool &enabled) {
+  ui->pushButton_start->setEnabled(enabled);
+  ui->pushButton->setEnabled(enabled);
+  ui->pushButton_addTargetFunction->setEnabled(enabled);
+  ui->pushButton_removeTargetFunction->setEnabled(enabled);
+}
+
+std::shared_ptr<EstimatorSnapshot> MainWindow::CreateSnapshot(const QString &frame_path) {
+  auto snapshot = std::make_shared<EstimatorSnapshot>();
+  snapshot->step_number_ = step_number_;
+  snapshot->frame_path_ = frame_path;
+  return snapshot;
+}
+
+/** Copies positions and weights of the clusters the KDE of DESDA is built on, and its smoothing parameters, to the
+ * snapshot, so that the GUI can evaluate the KDE itself.
+ * @brief Copies the state of the KDE of DESDA to the snapshot.
+ */
+void MainWindow::AddClustersToSnapshot(DESDA *DESDAAlgorithm, EstimatorSnapshot *snapshot) {
+  size_t clusters_number = std::min(static_cast<size_t>(std::max(DESDAAlgorithm->_m, 0)), clusters_->size());
+  std::vector<std::shared_ptr<cluster>> estimator_clusters(clusters_->begin(), clusters_->begin() + clusters_number);
+
+  for(const auto &c : estimator_clusters) {
+    snapshot->clusters_positions_.push_back(std::stod(c->getObject()->attributesValues["Val0"]));
+  }
+
+  snapshot->clusters_weights_ = DESDAAlgorithm->getClustersWeights(estimator_clusters);
+  snapshot->smoothing_parameters_ = DESDAAlgorithm->_smoothingParametersVector;
+}
+
+/** Evaluates the KDE built on the clusters of the snapshot on the drawable domain, on the GUI thread. Values match the
+ * ones of DESDA, except for the cut off 5 windowed smoothing parameters away from the clusters, which DESDA applies
+ * and which is negligible on the plot.
+ * @brief Evaluates the KDE from the snapshot on the drawable domain.
+ * @param estimator - Estimator of the GUI thread, providing the kernel.
+ * @param should_consider_weights - Whether the weights of the clusters are considered.
+ */
+std::vector<double> MainWindow::GetSnapshotKDEValues(const EstimatorSnapshot &snapshot,
+                                                     kernelDensityEstimator *estimator,
+                                                     const bool &should_consider_weights) {
+  std::vector<double> values(drawable_domain_.size(), 0);
+
+  if(snapshot.clusters_positions_.empty() || snapshot.smoothing_parameters_.empty()) return values;
+
+  double h = snapshot.smoothing_parameters_[0];
+  double weights_sum = 0;
+  estimator->setSmoothingParameters({h});
+
+  for(size_t i = 0; i < snapshot.clusters_positions_.size(); ++i) {
+    weights_sum += should_consider_weights ? snapshot.clusters_weights_[i] : 1;
+  }
+
+  if(weights_sum <= 0) return values;
+
+  std::vector<double> x = {0}, position = {0};
+
+  for(int j = 0; j < drawable_domain_.size(); ++j) {
+    x[0] = drawable_domain_[j];
+
+    for(size_t i = 0; i < snapshot.clusters_positions_.size(); ++i) {
+      position[0] = snapshot.clusters_positions_[i];
+      double addend = estimator->getProductKernelAddendFromSample(&position, &x);
+      values[j] += should_consider_weights ? snapshot.clusters_weights_[i] * addend : addend;
+    }
+
+    values[j] /= h * weights_sum;
+  }
+
+  return values;
+}
+
+/** Updates the KDE curves with the ones evaluated from the live snapshot. Other curves need parts of the state of the
+ * estimator that snapshot doesn't have (derivatives, enhanced weights, moving target function), so they are left as
+ * they were in the last frame.
+ * @brief Updates the KDE curves from the live snapshot.
+ */
+void MainWindow::DrawLiveCurves(const EstimatorSnapshot &snapshot, kernelDensityEstimator *estimator) {
+  auto curves_check_boxes = GetCurvesCheckBoxes();
+
+  if(curves_check_boxes["kde"]->isChecked()) {
+    AddPlot("kde", GetSnapshotKDEValues(snapshot, estimator, false), kde_plot_pen_);
+  }
+
+  if(curves_check_boxes["weighted_kde"]->isChecked()) {
+    AddPlot("weighted_kde", GetSnapshotKDEValues(snapshot, estimator, true), weighted_plot_pen_);
+  }
+}
+
+/** Updates the values presented by the labels with the ones from the snapshot. Labels point to these values instead
+ * of the state of the estimator, as it's changed by the worker.
+ * @brief Updates the values presented by the labels.
+ */
+void MainWindow::UpdateDisplayedValues(const EstimatorSnapshot &snapshot) {
+  for(auto &value : displayed_double_values_) {
+    auto snapshot_value = snapshot.double_values_.find(value.first);
+    if(snapshot_value != snapshot.double_values_.end()) value.second = snapshot_value->second;
+  }
+
+  for(auto &value : displayed_int_values_) {
+    auto snapshot_value = snapshot.int_values_.find(value.first);
+    if(snapshot_value != snapshot.int_values_.end()) value.second = snapshot_value->second;
+  }
+}
+
 void MainWindow::resizeEvent(QResizeEvent *event) {
   int offset = 10; // Offset in px, so that scale is in
   QMainWindow::resizeEvent(event);
@@ -1316,6 +1484,10 @@ void MainWindow::Run1DExperimentWithDESDA() {
   //QString dirPath = driveDir + "Badania PK\\Eksperyment " + expNum + " (" + expDesc + ")\\";
   //QString dirPath = driveDir + "Eksperyment " + expNum + " (" + expDesc + ")\\";
 
+  // Raw curves of the drawn steps are dumped for offline rendering (KerDEPDumpRenderer) instead of PNG frames.
+  bool dump_curves = false;
+  CurveDumpWriter curve_dump_writer;
+
   ClearPlot();
   ResizePlot();
 
@@ -1333,7 +1505,7 @@ void MainWindow::Run1DExperimentWithDESDA() {
 
   QString imageName = dirPath + QString::number(0) + ".png";
 
-  log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+  ExportPlotFrame(imageName, 0);
   expNumLabel.setText("");
 
   // Exps with days
@@ -1348,6 +1520,8 @@ void MainWindow::Run1DExperimentWithDESDA() {
   QDateTime dateTime(startDate, startTime);
 
   plot_labels_ = {};
+  displayed_double_values_.clear();
+  displayed_int_values_.clear();
   label_horizontal_offset_ = 0.02;
   label_vertical_offset_ = 0.01;
 
@@ -1369,7 +1543,7 @@ void MainWindow::Run1DExperimentWithDESDA() {
   }
   //*/
 
-  AddIntLabelToPlot("t          = ", &step_number_);
+  AddIntLabelToPlot("t          = ", &displayed_int_values_["t"]);
   // AddConstantLabelToPlot("iw    = " + QString::number(screen_generation_frequency_));
   // AddConstantLabelToPlot("seed  = " + seedString);
   label_vertical_offset_ += label_vertical_offset_step_;
@@ -1377,11 +1551,11 @@ void MainWindow::Run1DExperimentWithDESDA() {
   plotLabel KPSSTextLabel(ui->widget_plot, label_horizontal_offset_, label_vertical_offset_, "KPSS         = 0");
   label_vertical_offset_ += label_vertical_offset_step_;
 
-  AddDoubleLabelToPlot("sgmKPSS    = ", &DESDAAlgorithm._sgmKPSS);
+  AddDoubleLabelToPlot("sgmKPSS    = ", &displayed_double_values_["sgmKPSS"]);
   label_vertical_offset_ += label_vertical_offset_step_;
 
   //AddConstantLabelToPlot("mKPSS = " + QString::number(DESDAAlgorithm._kpssM));
-  AddIntLabelToPlot("m          = ", &(DESDAAlgorithm._m));
+  AddIntLabelToPlot("m          = ", &displayed_int_values_["m"]);
   //AddConstantLabelToPlot("m_min      = " + QString::number(DESDAAlgorithm._minM));
   //AddConstantLabelToPlot("m_0        = " + ui->lineEdit_sampleSize->text());
   label_vertical_offset_ += label_vertical_offset_step_;
@@ -1389,9 +1563,9 @@ void MainWindow::Run1DExperimentWithDESDA() {
   //AddDoubleLabelToPlot("beta0 = ", &(DESDAAlgorithm._beta0));
   //label_vertical_offset_ += label_vertical_offset_step_;
 
-  AddDoubleLabelToPlot("r          = ", &(DESDAAlgorithm._r));
-  AddDoubleLabelToPlot("q          = ", &(DESDAAlgorithm._quantileEstimator));
-  AddIntLabelToPlot("#atypical  = ", &(DESDAAlgorithm._rareElementsNumber));
+  AddDoubleLabelToPlot("r          = ", &displayed_double_values_["r"]);
+  AddDoubleLabelToPlot("q          = ", &displayed_double_values_["q"]);
+  AddIntLabelToPlot("#atypical  = ", &displayed_int_values_["#atypical"]);
   //AddIntLabelToPlot("trend = ", &(DESDAAlgorithm._trendsNumber));
   label_vertical_offset_ += 5 * label_vertical_offset_step_;
 
@@ -1416,6 +1590,7 @@ void MainWindow::Run1DExperimentWithDESDA() {
   QVector<double_ptr> l2_errors = {};
   QVector<double_ptr> sup_errors = {};
   QVector<double_ptr> mod_errors = {};
+  QVector<double_ptr> displayed_l2_errors = {};
 
   if(compute_errors) {
 
@@ -1429,6 +1604,7 @@ void MainWindow::Run1DExperimentWithDESDA() {
       //l1_errors_sums.push_back(0);
       l2_errors.push_back(std::make_shared<double>(0));
       l2_errors_sums.push_back(0);
+      displayed_l2_errors.push_back(std::make_shared<double>(0));
       //sup_errors.push_back(std::make_shared<double>(0));
       //sup_errors_sums.push_back(0);
       //mod_errors.push_back(std::make_shared<double>(0));
@@ -1438,7 +1614,7 @@ void MainWindow::Run1DExperimentWithDESDA() {
     //AddErrorLabelsToPlot(l1_labels, l1_errors);
     //label_vertical_offset_ += label_vertical_offset_step_;
 
-    AddErrorLabelsToPlot(l2_labels, l2_errors);
+    AddErrorLabelsToPlot(l2_labels, displayed_l2_errors);
     label_vertical_offset_ += label_vertical_offset_step_;
 
     //AddErrorLabelsToPlot(sup_labels, sup_errors);
@@ -1490,92 +1666,196 @@ void MainWindow::Run1DExperimentWithDESDA() {
       &enhanced_kde_errors_calculator, &rare_elements_kde_errors_calculator
   };
 
+  if(dump_curves) {
+    std::vector<std::string> scalars_names = {
+        "KPSS", "sgmKPSS", "m", "r", "q", "#atypical",
+        "L2_windowed_kde", "L2_kde", "L2_weighted_kde", "L2_enhanced_kde", "L2_rare_elements_kde"
+    };
+
+    curve_dump_writer.Open((dirPath + "curves.kdpc").toStdString(), desda_dump_curves_names_, scalars_names);
+  }
 
-  for(step_number_ = 1; step_number_ <= stepsNumber; ++step_number_) {
-    clock_t executionStartTime = clock();
+  EstimatorSnapshotBuffer snapshot_buffer;
+  auto shown_curves_names = GetShownCurvesNames();
+  auto drawable_domain = GetDrawableDomainPoints();
+  bool mark_uncommon_clusters = ui->checkBox_showUnusualClusters->isChecked();
+  std::unique_ptr<kernelDensityEstimator> live_estimator(GenerateKernelDensityEstimator(dimensionsNumber));
 
-    DESDAAlgorithm.performStep();
+  auto add_state_to_snapshot = [&](EstimatorSnapshot *snapshot) {
+    AddClustersToSnapshot(&DESDAAlgorithm, snapshot);
+
+    snapshot->double_values_ = {
+        {"KPSS", DESDAAlgorithm.getStationarityTestValue()}, {"sgmKPSS", DESDAAlgorithm._sgmKPSS},
+        {"r", DESDAAlgorithm._r}, {"q", DESDAAlgorithm._quantileEstimator}
+    };
+    snapshot->int_values_ = {
+        {"t", step_number_}, {"m", DESDAAlgorithm._m}, {"#atypical", DESDAAlgorithm._rareElementsNumber}
+    };
+    snapshot->text_values_["date"] = QLocale(QLocale::English).toString(dateTime, "dd MMM yyyy, hh:mm");
+  };
+
+  auto estimator_loop = [&]() {
+    for(step_number_ = 1; step_number_ <= stepsNumber && !snapshot_buffer.IsClosed(); ++step_number_) {
+      clock_t executionStartTime = clock();
+
+      DESDAAlgorithm.performStep();
+
+      target_function_->setMeans(means_);
+
+      if(step_number_ % screen_generation_frequency_ == 0 || step_number_ < 10
+         || additionalScreensSteps.contains(step_number_)) {
+        log("Drawing in step number " + QString::number(step_number_) + ".");
+
+        kernel_prognosis_derivative_values_ =
+            DESDAAlgorithm.getKernelPrognosisDerivativeValues(&drawable_domain_);
+
+        // Error calculations
+        if(step_number_ >= 1000 && compute_errors) {
 
-    target_function_.reset(GenerateTargetFunction(&means_, &standard_deviations_));
-
-    if(step_number_ % screen_generation_frequency_ == 0 || step_number_ < 10
-       || additionalScreensSteps.contains(step_number_)) {
-      log("Drawing in step number " + QString::number(step_number_) + ".");
-
-      kernel_prognosis_derivative_values_ =
-          DESDAAlgorithm.getKernelPrognosisDerivativeValues(&drawable_domain_);
-
-      // Error calculations
-      if(step_number_ >= 1000 && compute_errors) {
-
-        log("Getting windowed domain.");
-        windowed_error_domain = Generate1DWindowedPlotErrorDomain(&DESDAAlgorithm);
-        log("Getting non-windowed domain.");
-        error_domain = Generate1DPlotErrorDomain(&DESDAAlgorithm);
-
-        log("Getting model plot on windowed.");
-        windowed_model_values = GetFunctionsValueOnDomain(target_function_.get(), windowed_error_domain);
-        log("Getting KDE plot on windowed.");
-        windowed_kde_values = DESDAAlgorithm.getWindowKDEValues(&windowed_error_domain);
-
-        log("Getting model plot.");
-        model_values = GetFunctionsValueOnDomain(target_function_.get(), error_domain);
-        log("Getting KDE plot on lesser elements.");
-        less_elements_kde_values = DESDAAlgorithm.getKDEValues(&error_domain);
-        log("Getting weighted KDE plot.");
-        weighted_kde_values = DESDAAlgorithm.getWeightedKDEValues(&error_domain);
-        log("Getting sgm KDE plot.");
-        enhanced_kde_values = DESDAAlgorithm.getEnhancedKDEValues(&error_domain);
-        log("Getting rare KDE plot.");
-        rare_elements_kde_values = DESDAAlgorithm.getRareElementsEnhancedKDEValues(&error_domain);
-
-        error_domain_length = error_domain[error_domain.size() - 1][0] - error_domain[0][0];
-        windowed_error_domain_length =
-            windowed_error_domain[windowed_error_domain.size() - 1][0] - windowed_error_domain[0][0];
-
-        //AddL1ErrorsToSum(errors_calculators, l1_errors_sums);
-        AddL2ErrorsToSum(errors_calculators, l2_errors_sums);
-        //AddSupErrorsToSum(errors_calculators, sup_errors_sums);
-        //AddModErrorsToSum(errors_calculators, mod_errors_sums);
-
-        for(size_t i = 0; i < errors_calculators.size(); ++i){
-          //*l1_errors[i] = l1_errors_sums[i] / numberOfErrorCalculations;
-          *l2_errors[i] = l2_errors_sums[i] / numberOfErrorCalculations;
-          //*sup_errors[i] = sup_errors_sums[i] / numberOfErrorCalculations;
-          //*mod_errors[i] = mod_errors_sums[i] / numberOfErrorCalculations;
+          log("Getting windowed domain.");
+          windowed_error_domain = Generate1DWindowedPlotErrorDomain(&DESDAAlgorithm);
+          log("Getting non-windowed domain.");
+          error_domain = Generate1DPlotErrorDomain(&DESDAAlgorithm);
+
+          log("Getting model plot on windowed.");
+          windowed_model_values = target_function_->getValues(windowed_error_domain);
+          log("Getting KDE plot on windowed.");
+          windowed_kde_values = DESDAAlgorithm.getWindowKDEValues(&windowed_error_domain);
+
+          log("Getting model plot.");
+          model_values = target_function_->getValues(error_domain);
+          log("Getting KDE plot on lesser elements.");
+          less_elements_kde_values = DESDAAlgorithm.getKDEValues(&error_domain);
+          log("Getting weighted KDE plot.");
+          weighted_kde_values = DESDAAlgorithm.getWeightedKDEValues(&error_domain);
+          log("Getting sgm KDE plot.");
+          enhanced_kde_values = DESDAAlgorithm.getEnhancedKDEValues(&error_domain);
+          log("Getting rare KDE plot.");
+          rare_elements_kde_values = DESDAAlgorithm.getRareElementsEnhancedKDEValues(&error_domain);
+
+          error_domain_length = error_domain[error_domain.size() - 1][0] - error_domain[0][0];
+          windowed_error_domain_length =
+              windowed_error_domain[windowed_error_domain.size() - 1][0] - windowed_error_domain[0][0];
+
+          AddErrorsToSums(errors_calculators, l1_errors_sums, l2_errors_sums, sup_errors_sums, mod_errors_sums);
+
+          for(size_t i = 0; i < errors_calculators.size(); ++i){
+            //*l1_errors[i] = l1_errors_sums[i] / numberOfErrorCalculations;
+            *l2_errors[i] = l2_errors_sums[i] / numberOfErrorCalculations;
+            //*sup_errors[i] = sup_errors_sums[i] / numberOfErrorCalculations;
+            //*mod_errors[i] = mod_errors_sums[i] / numberOfErrorCalculations;
+          }
+
+          ++numberOfErrorCalculations;
         }
 
-        ++numberOfErrorCalculations;
-      }
+        if(dump_curves) {
+          auto frame = GenerateCurveDumpFrame(&DESDAAlgorithm);
 
-      // ============= LEFT SIDE UPDATE ================ //
+          frame.scalars_ = {
+              DESDAAlgorithm.getStationarityTestValue(), DESDAAlgorithm._sgmKPSS,
+              static_cast<double>(DESDAAlgorithm._m), DESDAAlgorithm._r, DESDAAlgorithm._quantileEstimator,
+              static_cast<double>(DESDAAlgorithm._rareElementsNumber)
+          };
 
-      KPSSTextLabel.setText("KPSS       = " + FormatNumberForDisplay(
-          DESDAAlgorithm.getStationarityTestValue()));
+          for(const auto &l2_error : l2_errors) {
+            frame.scalars_.push_back(*l2_error);
+          }
 
-      DrawPlots(&DESDAAlgorithm);
+          curve_dump_writer.AppendFrame(frame);
+        } else {
+          auto snapshot = CreateSnapshot(dirPath + QString::number(step_number_) + ".png");
 
-      for(const auto &label : plot_labels_){
-        label->updateText();
-      }
+          for(const auto &name : desda_dump_curves_names_) {
+            if(shown_curves_names.count(name) == 0) continue;
+
+            snapshot->AddCurve(name, GetCurveValues(&DESDAAlgorithm, name, &drawable_domain));
+          }
 
+          add_state_to_snapshot(snapshot.get());
 
-      for(auto i = 0; i < date_labels.size(); ++i) {
-        date_labels[i].setText(QLocale(QLocale::English).toString(dateTime, "dd MMM yyyy, hh:mm"));
+          for(int i = 0; i < l2_errors.size(); ++i) {
+            snapshot->double_values_["L2_" + std::to_string(i)] = *l2_errors[i];
+          }
+
+          if(mark_uncommon_clusters) {
+            auto atypical_elements_values_and_derivatives = DESDAAlgorithm.getAtypicalElementsValuesAndDerivatives();
+            snapshot->atypical_elements_values_and_derivatives_ = std::vector<std::pair<double, double>>(
+                atypical_elements_values_and_derivatives.begin(), atypical_elements_values_and_derivatives.end());
+            snapshot->quantile_estimator_value_ = DESDAAlgorithm._quantileEstimator;
+          }
+
+          snapshot_buffer.PublishFrame(snapshot);
+        }
       }
 
-      ui->widget_plot->replot();
-      QCoreApplication::processEvents();
+      if(snapshot_buffer.IsLatestTaken()) {
+        auto snapshot = CreateSnapshot();
+        add_state_to_snapshot(snapshot.get());
+        snapshot_buffer.PublishLatest(snapshot);
+      }
+
+      dateTime = dateTime.addSecs(3600); // Bike sharing
+    }
+  };
+
+  auto render = [&](const EstimatorSnapshot &snapshot) {
+    // ============= LEFT SIDE UPDATE ================ //
 
-      if(!QDir(dirPath).exists()) QDir().mkdir(dirPath);
+    UpdateDisplayedValues(snapshot);
 
-      imageName = dirPath + QString::number(step_number_) + ".png";
-      log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+    for(int i = 0; i < displayed_l2_errors.size(); ++i) {
+      *displayed_l2_errors[i] = snapshot.double_values_.at("L2_" + std::to_string(i));
     }
 
-    dateTime = dateTime.addSecs(3600); // Bike sharing
+    KPSSTextLabel.setText("KPSS       = " + FormatNumberForDisplay(snapshot.double_values_.at("KPSS")));
+
+    DrawPlots(snapshot);
+
+    for(const auto &label : plot_labels_){
+      label->updateText();
+    }
+
+    for(auto i = 0; i < date_labels.size(); ++i) {
+      date_labels[i].setText(snapshot.text_values_.at("date"));
+    }
+
+    plot_curves_->Replot();
+  };
+
+  auto render_live = [&](const EstimatorSnapshot &snapshot) {
+    UpdateDisplayedValues(snapshot);
+
+    KPSSTextLabel.setText("KPSS       = " + FormatNumberForDisplay(snapshot.double_values_.at("KPSS")));
+
+    DrawLiveCurves(snapshot, live_estimator.get());
+
+    for(const auto &label : plot_labels_){
+      label->updateText();
+    }
+
+    for(auto i = 0; i < date_labels.size(); ++i) {
+      date_labels[i].setText(snapshot.text_values_.at("date"));
+    }
+
+    plot_curves_->Replot();
+  };
+
+  RunEstimatorLoop(&snapshot_buffer, estimator_loop, render, render_live);
+
+#ifdef KERDEP_PROFILING
+  StepProfiler::Instance().ExportToCSV((dirPath + "profile.csv").toStdString());
+  StepProfiler::Instance().ExportToJSON((dirPath + "profile.json").toStdString());
+  StepProfiler::Instance().Clear();
+#endif
+
+  if(dump_curves) {
+    curve_dump_writer.Close();
+    log("Frames dumped: " + QString::number(curve_dump_writer.GetFramesNumber()));
   }
 
+  frame_export_pipeline_->Flush();
+
   log("Animation finished.");
 }
 
@@ -1594,8 +1874,6 @@ void MainWindow::Run1DExperimentWithClusterKernels() {
 
   int number_of_cluster_kernels = 100;
   step_number_ = 0;
-  double h = 1;
-  double sigma = 0;
 
   srand(static_cast<unsigned int>(seedString.toInt()));
 
@@ -1653,15 +1931,17 @@ void MainWindow::Run1DExperimentWithClusterKernels() {
 
   QString imageName = dirPath + QString::number(0) + ".png";
 
-  log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+  ExportPlotFrame(imageName, 0);
   expNumLabel.setText("");
 
   // Setting up the labels
   QVector<std::shared_ptr<plotLabel>> plotLabels = {};
+  displayed_double_values_.clear();
+  displayed_int_values_.clear();
   double horizontalOffset = 0.01, verticalOffset = 0.01, verticalStep = 0.03;
 
   plotLabels.push_back(std::make_shared<plotLabel>(ui->widget_plot,
-                                                   horizontalOffset, verticalOffset, "i     = ", &step_number_,
+                                                   horizontalOffset, verticalOffset, "i     = ", &displayed_int_values_["i"],
                                                    std::make_shared<plotLabelIntDataPreparator>()));
   verticalOffset += verticalStep;
 
@@ -1685,11 +1965,11 @@ void MainWindow::Run1DExperimentWithClusterKernels() {
   verticalOffset += verticalStep;
 
   plotLabels.push_back(std::make_shared<plotLabel>(ui->widget_plot,
-                                                   horizontalOffset, verticalOffset, "h     = ", &(h),
+                                                   horizontalOffset, verticalOffset, "h     = ", &displayed_double_values_["h"],
                                                    std::make_shared<plotLabelDoubleDataPreparator>()));
   verticalOffset += verticalStep;
   plotLabels.push_back(std::make_shared<plotLabel>(ui->widget_plot,
-                                                   horizontalOffset, verticalOffset, "sigma = ", &(sigma),
+                                                   horizontalOffset, verticalOffset, "sigma = ", &displayed_double_values_["sigma"],
                                                    std::make_shared<plotLabelDoubleDataPreparator>()));
 
 
@@ -1759,95 +2039,124 @@ void MainWindow::Run1DExperimentWithClusterKernels() {
   double sup_sum = 0;
   double mod_sum = 0;
 
-  for(step_number_ = 1; step_number_ < stepsNumber; ++step_number_) {
-    clock_t executionStartTime = clock();
-    Point stream_value = {};
-    reader_->getNextRawDatum(&stream_value);
-    UnivariateStreamElement element(stream_value);
+  EstimatorSnapshotBuffer snapshot_buffer;
+  auto shown_curves_names = GetShownCurvesNames();
+  auto drawable_domain = GetDrawableDomainPoints();
 
-    log("Performing step: " + QString::number(step_number_));
-    CKAlgorithm.PerformStep(&element);
-    log("Step performed.");
+  auto estimator_loop = [&]() {
+    for(step_number_ = 1; step_number_ < stepsNumber && !snapshot_buffer.IsClosed(); ++step_number_) {
+      clock_t executionStartTime = clock();
+      Point stream_value = {};
+      reader_->getNextRawDatum(&stream_value);
+      UnivariateStreamElement element(stream_value);
 
-    target_function_.reset(GenerateTargetFunction(&means_, &standard_deviations_));
+      log("Performing step: " + QString::number(step_number_));
+      CKAlgorithm.PerformStep(&element);
+      log("Step performed.");
 
-    if(step_number_ % screen_generation_frequency_ == 0 || step_number_ < 10
-       || additionalScreensSteps.contains(step_number_)) {
-      log("Drawing in step number " + QString::number(step_number_) + ".");
+      target_function_->setMeans(means_);
 
-      // Error calculations
-      if(step_number_ >= 1) {
+      if(step_number_ % screen_generation_frequency_ == 0 || step_number_ < 10
+         || additionalScreensSteps.contains(step_number_)) {
+        log("Drawing in step number " + QString::number(step_number_) + ".");
 
-        log("Getting error domain.");
-        error_domain = CKAlgorithm.GetErrorDomain();
+        // Error calculations
+        if(step_number_ >= 1) {
 
-        log("Getting model plot on windowed.");
-        model_values = GetFunctionsValueOnDomain(target_function_.get(), error_domain);
-        log("Getting KDE plot on windowed.");
-        kde_values = CKAlgorithm.GetKDEValuesOnDomain(error_domain);
+          log("Getting error domain.");
+          error_domain = CKAlgorithm.GetErrorDomain();
 
-        log("Getting model plot.");
-        model_values = GetFunctionsValueOnDomain(target_function_.get(), error_domain);
+          log("Getting model plot on windowed.");
+          model_values = target_function_->getValues(error_domain);
+          log("Getting KDE plot on windowed.");
+          kde_values = CKAlgorithm.GetKDEValuesOnDomain(error_domain);
 
-        log("Calculating domain length.");
+          log("Getting model plot.");
+          model_values = target_function_->getValues(error_domain);
 
-        error_domain_length =
-            error_domain[error_domain.size() - 1][0] - error_domain[0][0];
+          log("Calculating domain length.");
 
-        log("Calculating errors.");
-        l1_w_ = errors_calculator.CalculateL1Error();
-        l2_w_ = errors_calculator.CalculateL2Error();
-        sup_w_ = errors_calculator.CalculateSupError();
-        mod_w_ = errors_calculator.CalculateModError();
-        l1_sum += l1_w_;
-        l2_sum += l2_w_;
-        sup_sum += sup_w_;
-        mod_sum += mod_w_;
+          error_domain_length =
+              error_domain[error_domain.size() - 1][0] - error_domain[0][0];
 
-        ++numberOfErrorCalculations;
-        log("Errors calculated.");
-      }
+          log("Calculating errors.");
+          auto errors = errors_calculator.CalculateErrors();
+          l1_w_ = errors.l1_;
+          l2_w_ = errors.l2_;
+          sup_w_ = errors.sup_;
+          mod_w_ = errors.mod_;
+          l1_sum += l1_w_;
+          l2_sum += l2_w_;
+          sup_sum += sup_w_;
+          mod_sum += mod_w_;
 
-      // ============ SUMS =========== //
-
-      L1TextLabel
-          .setText("L1   =" + FormatNumberForDisplay(
-              l1_sum / numberOfErrorCalculations));
-      L2TextLabel
-          .setText("L2   =" + FormatNumberForDisplay(
-              l2_sum / numberOfErrorCalculations));
-      supTextLabel
-          .setText("sup  =" + FormatNumberForDisplay(
-              sup_sum / numberOfErrorCalculations));
-      modTextLabel
-          .setText("mod  =" + FormatNumberForDisplay(
-              mod_sum / numberOfErrorCalculations));
-
-      L1aTextLabel
-          .setText("L1a  =" + FormatNumberForDisplay(l1_w_));
-      L2aTextLabel
-          .setText("L2a  =" + FormatNumberForDisplay(l2_w_));
-      supaTextLabel
-          .setText("supa =" + FormatNumberForDisplay(sup_w_));
-      modaTextLabel
-          .setText("moda =" + FormatNumberForDisplay(mod_w_));
-
-      DrawPlots(&CKAlgorithm);
-
-      h = CKAlgorithm.GetBandwidth();
-      sigma = CKAlgorithm.GetStandardDeviation();
-
-      for(const auto &label : plotLabels) label->updateText();
-
-      ui->widget_plot->replot();
-      QCoreApplication::processEvents();
+          ++numberOfErrorCalculations;
+          log("Errors calculated.");
+        }
+
+        auto snapshot = CreateSnapshot(dirPath + QString::number(step_number_) + ".png");
 
-      if(!QDir(dirPath).exists()) QDir().mkdir(dirPath);
+        if(shown_curves_names.count("model") != 0) {
+          snapshot->AddCurve("model", target_function_->getValues(drawable_domain));
+        }
+
+        if(shown_curves_names.count("kde") != 0) {
+          snapshot->AddCurve("kde", CKAlgorithm.GetKDEValuesOnDomain(drawable_domain));
+        }
 
-      imageName = dirPath + QString::number(step_number_) + ".png";
-      log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+        snapshot->double_values_ = {
+            {"L1", l1_sum / numberOfErrorCalculations}, {"L2", l2_sum / numberOfErrorCalculations},
+            {"sup", sup_sum / numberOfErrorCalculations}, {"mod", mod_sum / numberOfErrorCalculations},
+            {"L1a", l1_w_}, {"L2a", l2_w_}, {"supa", sup_w_}, {"moda", mod_w_}, {"h", CKAlgorithm.GetBandwidth()},
+            {"sigma", CKAlgorithm.GetStandardDeviation()}
+        };
+        snapshot->int_values_ = {{"i", step_number_}};
+
+        snapshot_buffer.PublishFrame(snapshot);
+      }
+
+      if(snapshot_buffer.IsLatestTaken()) {
+        auto snapshot = CreateSnapshot();
+        snapshot->double_values_ = {{"h", CKAlgorithm.GetBandwidth()}, {"sigma", CKAlgorithm.GetStandardDeviation()}};
+        snapshot->int_values_ = {{"i", step_number_}};
+        snapshot_buffer.PublishLatest(snapshot);
+      }
     }
-  }
+  };
+
+  auto render = [&](const EstimatorSnapshot &snapshot) {
+    // ============ SUMS =========== //
+
+    L1TextLabel.setText("L1   =" + FormatNumberForDisplay(snapshot.double_values_.at("L1")));
+    L2TextLabel.setText("L2   =" + FormatNumberForDisplay(snapshot.double_values_.at("L2")));
+    supTextLabel.setText("sup  =" + FormatNumberForDisplay(snapshot.double_values_.at("sup")));
+    modTextLabel.setText("mod  =" + FormatNumberForDisplay(snapshot.double_values_.at("mod")));
+
+    L1aTextLabel.setText("L1a  =" + FormatNumberForDisplay(snapshot.double_values_.at("L1a")));
+    L2aTextLabel.setText("L2a  =" + FormatNumberForDisplay(snapshot.double_values_.at("L2a")));
+    supaTextLabel.setText("supa =" + FormatNumberForDisplay(snapshot.double_values_.at("supa")));
+    modaTextLabel.setText("moda =" + FormatNumberForDisplay(snapshot.double_values_.at("moda")));
+
+    UpdateDisplayedValues(snapshot);
+    DrawPlots(snapshot);
+
+    for(const auto &label : plotLabels) label->updateText();
+
+    plot_curves_->Replot();
+  };
+
+  // Cluster kernels aren't plain weighted points with one bandwidth, so live view only updates the labels.
+  auto render_live = [&](const EstimatorSnapshot &snapshot) {
+    UpdateDisplayedValues(snapshot);
+
+    for(const auto &label : plotLabels) label->updateText();
+
+    plot_curves_->Replot();
+  };
+
+  RunEstimatorLoop(&snapshot_buffer, estimator_loop, render, render_live);
+
+  frame_export_pipeline_->Flush();
 
   log("Animation finished.");
 }
@@ -1904,7 +2213,6 @@ void MainWindow::Run1DExperimentWithWDE() {
   int sampleSize = ui->lineEdit_sampleSize->text().toInt();
   double weight_modifier = 0.95; // omega
   unsigned int maximal_number_of_coefficients = 100; // M
-  unsigned int current_coefficients_number = 0; // #coef
   int number_of_elements_per_block = 1000; // b
 
   QString expNum = "1491 TEST (Thresholded Weighted Window WDE)";
@@ -1933,14 +2241,16 @@ void MainWindow::Run1DExperimentWithWDE() {
 
   QString imageName = dirPath + QString::number(0) + ".png";
 
-  log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+  ExportPlotFrame(imageName, 0);
   expNumLabel.setText("");
 
   QVector<std::shared_ptr<plotLabel>> plotLabels = {};
+  displayed_double_values_.clear();
+  displayed_int_values_.clear();
   double horizontalOffset = 0.01, verticalOffset = 0.01, verticalStep = 0.03;
 
   plotLabels.push_back(std::make_shared<plotLabel>(ui->widget_plot,
-                                                   horizontalOffset, verticalOffset, "i     = ", &step_number_,
+                                                   horizontalOffset, verticalOffset, "i     = ", &displayed_int_values_["i"],
                                                    std::make_shared<plotLabelIntDataPreparator>()));
   verticalOffset += verticalStep;
 
@@ -1969,7 +2279,7 @@ void MainWindow::Run1DExperimentWithWDE() {
 
   plotLabels.push_back(std::make_shared<plotLabel>(ui->widget_plot,
                                                    horizontalOffset, verticalOffset, "#coef = ",
-                                                   &(current_coefficients_number),
+                                                   &displayed_int_values_["#coef"],
                                                    std::make_shared<plotLabelIntDataPreparator>()));
   verticalOffset += verticalStep;
 
@@ -2043,92 +2353,124 @@ void MainWindow::Run1DExperimentWithWDE() {
   double sup_sum = 0;
   double mod_sum = 0;
 
-  for(step_number_ = 1; step_number_ < stepsNumber; ++step_number_) {
-    clock_t executionStartTime = clock();
-    Point stream_value = {};
-    reader_->getNextRawDatum(&stream_value);
+  EstimatorSnapshotBuffer snapshot_buffer;
+  auto shown_curves_names = GetShownCurvesNames();
+  auto drawable_domain = GetDrawableDomainPoints();
 
-    log("Performing step: " + QString::number(step_number_));
-    WDE_Algorithm.PerformStep(&stream_value);
-    log("Step performed.");
+  auto estimator_loop = [&]() {
+    for(step_number_ = 1; step_number_ < stepsNumber && !snapshot_buffer.IsClosed(); ++step_number_) {
+      clock_t executionStartTime = clock();
+      Point stream_value = {};
+      reader_->getNextRawDatum(&stream_value);
 
-    target_function_.reset(GenerateTargetFunction(&means_, &standard_deviations_));
+      log("Performing step: " + QString::number(step_number_));
+      WDE_Algorithm.PerformStep(&stream_value);
+      log("Step performed.");
 
-    if(step_number_ % screen_generation_frequency_ == 0 || additionalScreensSteps.contains(step_number_)) {
-      log("Drawing in step number " + QString::number(step_number_) + ".");
+      target_function_->setMeans(means_);
 
-      // Error calculations
-      if(step_number_ >= 1000) {
+      if(step_number_ % screen_generation_frequency_ == 0 || additionalScreensSteps.contains(step_number_)) {
+        log("Drawing in step number " + QString::number(step_number_) + ".");
 
-        log("Getting error domain.");
-        error_domain = WDE_Algorithm.GetErrorDomain();
+        // Error calculations
+        if(step_number_ >= 1000) {
 
-        log("Getting model plot on windowed.");
-        model_values = GetFunctionsValueOnDomain(target_function_.get(), error_domain);
-        log("Getting KDE plot on windowed.");
-        wde_values = WDE_Algorithm.GetEstimatorValuesOnDomain(error_domain);
+          log("Getting error domain.");
+          error_domain = WDE_Algorithm.GetErrorDomain();
 
-        log("Getting model plot.");
-        model_values = GetFunctionsValueOnDomain(target_function_.get(), error_domain);
+          log("Getting model plot on windowed.");
+          model_values = target_function_->getValues(error_domain);
+          log("Getting KDE plot on windowed.");
+          wde_values = WDE_Algorithm.GetEstimatorValuesOnDomain(error_domain);
 
-        log("Calculating domain length.");
+          log("Getting model plot.");
+          model_values = target_function_->getValues(error_domain);
 
-        error_domain_length =
-            error_domain[error_domain.size() - 1][0] - error_domain[0][0];
+          log("Calculating domain length.");
 
-        log("Calculating errors.");
-        l1_w_ = errors_calculator.CalculateL1Error();
-        l2_w_ = errors_calculator.CalculateL2Error();
-        sup_w_ = errors_calculator.CalculateSupError();
-        mod_w_ = errors_calculator.CalculateModError();
-        l1_sum += l1_w_;
-        l2_sum += l2_w_;
-        sup_sum += sup_w_;
-        mod_sum += mod_w_;
+          error_domain_length =
+              error_domain[error_domain.size() - 1][0] - error_domain[0][0];
 
-        ++numberOfErrorCalculations;
-        log("Errors calculated.");
-      }
+          log("Calculating errors.");
+          auto errors = errors_calculator.CalculateErrors();
+          l1_w_ = errors.l1_;
+          l2_w_ = errors.l2_;
+          sup_w_ = errors.sup_;
+          mod_w_ = errors.mod_;
+          l1_sum += l1_w_;
+          l2_sum += l2_w_;
+          sup_sum += sup_w_;
+          mod_sum += mod_w_;
 
-      // ============ SUMS =========== //
-
-      L1TextLabel
-          .setText("L1   =" + FormatNumberForDisplay(
-              l1_sum / numberOfErrorCalculations));
-      L2TextLabel
-          .setText("L2   =" + FormatNumberForDisplay(
-              l2_sum / numberOfErrorCalculations));
-      supTextLabel
-          .setText("sup  =" + FormatNumberForDisplay(
-              sup_sum / numberOfErrorCalculations));
-      modTextLabel
-          .setText("mod  =" + FormatNumberForDisplay(
-              mod_sum / numberOfErrorCalculations));
-
-      L1aTextLabel
-          .setText("L1a  =" + FormatNumberForDisplay(l1_w_));
-      L2aTextLabel
-          .setText("L2a  =" + FormatNumberForDisplay(l2_w_));
-      supaTextLabel
-          .setText("supa =" + FormatNumberForDisplay(sup_w_));
-      modaTextLabel
-          .setText("moda =" + FormatNumberForDisplay(mod_w_));
-
-      current_coefficients_number = WDE_Algorithm.GetCurrentCoefficientsNumber();
-
-      DrawPlots(&WDE_Algorithm);
-
-      for(const auto &label : plotLabels) label->updateText();
-
-      ui->widget_plot->replot();
-      QCoreApplication::processEvents();
+          ++numberOfErrorCalculations;
+          log("Errors calculated.");
+        }
 
-      if(!QDir(dirPath).exists()) QDir().mkdir(dirPath);
+        auto snapshot = CreateSnapshot(dirPath + QString::number(step_number_) + ".png");
 
-      imageName = dirPath + QString::number(step_number_) + ".png";
-      log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+        if(shown_curves_names.count("model") != 0) {
+          snapshot->AddCurve("model", target_function_->getValues(drawable_domain));
+        }
+
+        if(shown_curves_names.count("kde") != 0) {
+          snapshot->AddCurve("kde", WDE_Algorithm.GetEstimatorValuesOnDomain(drawable_domain));
+        }
+
+        snapshot->double_values_ = {
+            {"L1", l1_sum / numberOfErrorCalculations}, {"L2", l2_sum / numberOfErrorCalculations},
+            {"sup", sup_sum / numberOfErrorCalculations}, {"mod", mod_sum / numberOfErrorCalculations},
+            {"L1a", l1_w_}, {"L2a", l2_w_}, {"supa", sup_w_}, {"moda", mod_w_}
+        };
+        snapshot->int_values_ = {
+            {"i", step_number_}, {"#coef", static_cast<int>(WDE_Algorithm.GetCurrentCoefficientsNumber())}
+        };
+
+        snapshot_buffer.PublishFrame(snapshot);
+      }
+
+      if(snapshot_buffer.IsLatestTaken()) {
+        auto snapshot = CreateSnapshot();
+        snapshot->int_values_ = {
+            {"i", step_number_}, {"#coef", static_cast<int>(WDE_Algorithm.GetCurrentCoefficientsNumber())}
+        };
+        snapshot_buffer.PublishLatest(snapshot);
+      }
     }
-  }
+  };
+
+  auto render = [&](const EstimatorSnapshot &snapshot) {
+    // ============ SUMS =========== //
+
+    L1TextLabel.setText("L1   =" + FormatNumberForDisplay(snapshot.double_values_.at("L1")));
+    L2TextLabel.setText("L2   =" + FormatNumberForDisplay(snapshot.double_values_.at("L2")));
+    supTextLabel.setText("sup  =" + FormatNumberForDisplay(snapshot.double_values_.at("sup")));
+    modTextLabel.setText("mod  =" + FormatNumberForDisplay(snapshot.double_values_.at("mod")));
+
+    L1aTextLabel.setText("L1a  =" + FormatNumberForDisplay(snapshot.double_values_.at("L1a")));
+    L2aTextLabel.setText("L2a  =" + FormatNumberForDisplay(snapshot.double_values_.at("L2a")));
+    supaTextLabel.setText("supa =" + FormatNumberForDisplay(snapshot.double_values_.at("supa")));
+    modaTextLabel.setText("moda =" + FormatNumberForDisplay(snapshot.double_values_.at("moda")));
+
+    UpdateDisplayedValues(snapshot);
+    DrawPlots(snapshot);
+
+    for(const auto &label : plotLabels) label->updateText();
+
+    plot_curves_->Replot();
+  };
+
+  // WDE is a sum of wavelets, not kernels on clusters, so live view only updates the labels.
+  auto render_live = [&](const EstimatorSnapshot &snapshot) {
+    UpdateDisplayedValues(snapshot);
+
+    for(const auto &label : plotLabels) label->updateText();
+
+    plot_curves_->Replot();
+  };
+
+  RunEstimatorLoop(&snapshot_buffer, estimator_loop, render, render_live);
+
+  frame_export_pipeline_->Flush();
 
   log("Experiment finished!");
 }
@@ -2220,14 +2562,16 @@ void MainWindow::Run1DExperimentWithSOMKE() {
 
   QString imageName = dirPath + QString::number(0) + ".png";
 
-  log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+  ExportPlotFrame(imageName, 0);
   expNumLabel.setText("");
 
   QVector<std::shared_ptr<plotLabel>> plotLabels = {};
+  displayed_double_values_.clear();
+  displayed_int_values_.clear();
   double horizontalOffset = 0.01, verticalOffset = 0.01, verticalStep = 0.03;
 
   plotLabels.push_back(std::make_shared<plotLabel>(ui->widget_plot,
-                                                   horizontalOffset, verticalOffset, "i     = ", &step_number_,
+                                                   horizontalOffset, verticalOffset, "i     = ", &displayed_int_values_["i"],
                                                    std::make_shared<plotLabelIntDataPreparator>()));
   verticalOffset += verticalStep;
 
@@ -2367,123 +2711,131 @@ void MainWindow::Run1DExperimentWithSOMKE() {
   double sup_sum = 0;
   double mod_sum = 0;
 
-  for(step_number_ = 1; step_number_ < stepsNumber; ++step_number_) {
-    clock_t executionStartTime = clock();
-    Point stream_value = {};
-    reader_->getNextRawDatum(&stream_value);
+  EstimatorSnapshotBuffer snapshot_buffer;
+  auto shown_curves_names = GetShownCurvesNames();
+  auto drawable_domain = GetDrawableDomainPoints();
 
-    log("Performing step: " + QString::number(step_number_));
-    somke_algorithm.PerformStep(stream_value);
-    log("Step performed.");
+  auto estimator_loop = [&]() {
+    for(step_number_ = 1; step_number_ < stepsNumber && !snapshot_buffer.IsClosed(); ++step_number_) {
+      clock_t executionStartTime = clock();
+      Point stream_value = {};
+      reader_->getNextRawDatum(&stream_value);
+
+      log("Performing step: " + QString::number(step_number_));
+      somke_algorithm.PerformStep(stream_value);
+      log("Step performed.");
+
+      target_function_->setMeans(means_);
+
+      if(step_number_ % screen_generation_frequency_ == 0 || additionalScreensSteps.contains(step_number_)) {
+        log("Drawing in step number " + QString::number(step_number_) + ".");
 
-    target_function_.reset(GenerateTargetFunction(&means_, &standard_deviations_));
+        // Error calculations
+        if(step_number_ >= 1000) {
 
-    if(step_number_ % screen_generation_frequency_ == 0 || additionalScreensSteps.contains(step_number_)) {
-      log("Drawing in step number " + QString::number(step_number_) + ".");
+          log("Getting error domain.");
+          error_domain = somke_algorithm.divergence_domain_;
 
-      // Error calculations
-      if(step_number_ >= 1000) {
+          log("Getting model plot on windowed.");
+          model_values = target_function_->getValues(error_domain);
+          log("Getting KDE plot on windowed.");
+          somke_values = {};
+          for(auto pt : error_domain) {
+            somke_values.push_back(somke_algorithm.GetValue(pt));
+          }
 
-        log("Getting error domain.");
-        error_domain = somke_algorithm.divergence_domain_;
+          log("Getting model plot.");
+          model_values = target_function_->getValues(error_domain);
 
-        log("Getting model plot on windowed.");
-        model_values = GetFunctionsValueOnDomain(target_function_.get(), error_domain);
-        log("Getting KDE plot on windowed.");
-        somke_values = {};
-        for(auto pt : error_domain) {
-          somke_values.push_back(somke_algorithm.GetValue(pt));
+          log("Calculating domain length.");
+
+          error_domain_length =
+              error_domain[error_domain.size() - 1][0] - error_domain[0][0];
+
+          log("Calculating errors.");
+          auto errors = errors_calculator.CalculateErrors();
+          l1_w_ = errors.l1_;
+          l2_w_ = errors.l2_;
+          sup_w_ = errors.sup_;
+          mod_w_ = errors.mod_;
+          l1_sum += l1_w_;
+          l2_sum += l2_w_;
+          sup_sum += sup_w_;
+          mod_sum += mod_w_;
+
+          ++numberOfErrorCalculations;
+          log("Errors calculated.");
         }
 
-        log("Getting model plot.");
-        model_values = GetFunctionsValueOnDomain(target_function_.get(), error_domain);
+        auto snapshot = CreateSnapshot(dirPath + QString::number(step_number_) + ".png");
 
-        log("Calculating domain length.");
+        if(shown_curves_names.count("model") != 0) {
+          snapshot->AddCurve("model", target_function_->getValues(drawable_domain));
+        }
 
-        error_domain_length =
-            error_domain[error_domain.size() - 1][0] - error_domain[0][0];
+        if(shown_curves_names.count("kde") != 0) {
+          std::vector<double> estimator_values = {};
 
-        log("Calculating errors.");
-        l1_w_ = errors_calculator.CalculateL1Error();
-        l2_w_ = errors_calculator.CalculateL2Error();
-        sup_w_ = errors_calculator.CalculateSupError();
-        mod_w_ = errors_calculator.CalculateModError();
-        l1_sum += l1_w_;
-        l2_sum += l2_w_;
-        sup_sum += sup_w_;
-        mod_sum += mod_w_;
+          for(auto pt : drawable_domain) {
+            estimator_values.push_back(somke_algorithm.GetValue(pt));
+          }
 
-        ++numberOfErrorCalculations;
-        log("Errors calculated.");
-      }
+          snapshot->AddCurve("kde", estimator_values);
+        }
 
-      // ============ SUMS =========== //
-
-      L1TextLabel
-          .setText("L1   =" + FormatNumberForDisplay(
-              l1_sum / numberOfErrorCalculations));
-      L2TextLabel
-          .setText("L2   =" + FormatNumberForDisplay(
-              l2_sum / numberOfErrorCalculations));
-      supTextLabel
-          .setText("sup  =" + FormatNumberForDisplay(
-              sup_sum / numberOfErrorCalculations));
-      modTextLabel
-          .setText("mod  =" + FormatNumberForDisplay(
-              mod_sum / numberOfErrorCalculations));
-
-      L1aTextLabel
-          .setText("L1a  =" + FormatNumberForDisplay(l1_w_));
-      L2aTextLabel
-          .setText("L2a  =" + FormatNumberForDisplay(l2_w_));
-      supaTextLabel
-          .setText("supa =" + FormatNumberForDisplay(sup_w_));
-      modaTextLabel
-          .setText("moda =" + FormatNumberForDisplay(mod_w_));
-
-      DrawPlots(&somke_algorithm);
-
-      for(const auto &label : plotLabels) label->updateText();
-
-      ui->widget_plot->replot();
-      QCoreApplication::processEvents();
+        snapshot->double_values_ = {
+            {"L1", l1_sum / numberOfErrorCalculations}, {"L2", l2_sum / numberOfErrorCalculations},
+            {"sup", sup_sum / numberOfErrorCalculations}, {"mod", mod_sum / numberOfErrorCalculations},
+            {"L1a", l1_w_}, {"L2a", l2_w_}, {"supa", sup_w_}, {"moda", mod_w_}
+        };
+        snapshot->int_values_ = {{"i", step_number_}};
 
-      if(!QDir(dirPath).exists()) QDir().mkdir(dirPath);
+        snapshot_buffer.PublishFrame(snapshot);
+      }
 
-      imageName = dirPath + QString::number(step_number_) + ".png";
-      log("Image saved: " + QString::number(ui->widget_plot->savePng(imageName, 0, 0, 1, -1)));
+      if(snapshot_buffer.IsLatestTaken()) {
+        auto snapshot = CreateSnapshot();
+        snapshot->int_values_ = {{"i", step_number_}};
+        snapshot_buffer.PublishLatest(snapshot);
+      }
     }
-  }
+  };
 
-  log("Experiment finished!");
-}
+  auto render = [&](const EstimatorSnapshot &snapshot) {
+    // ============ SUMS =========== //
 
-void MainWindow::DrawPlots(SOMKEAlgorithm *somke_algorithm) {
-  ClearPlot();
-  ResizePlot();
+    L1TextLabel.setText("L1   =" + FormatNumberForDisplay(snapshot.double_values_.at("L1")));
+    L2TextLabel.setText("L2   =" + FormatNumberForDisplay(snapshot.double_values_.at("L2")));
+    supTextLabel.setText("sup  =" + FormatNumberForDisplay(snapshot.double_values_.at("sup")));
+    modTextLabel.setText("mod  =" + FormatNumberForDisplay(snapshot.double_values_.at("mod")));
 
-  std::vector<std::vector<double>> drawable_domain = {}; // This is required for types :P
-  for(auto value : drawable_domain_) {
-    drawable_domain.push_back({value});
-  }
+    L1aTextLabel.setText("L1a  =" + FormatNumberForDisplay(snapshot.double_values_.at("L1a")));
+    L2aTextLabel.setText("L2a  =" + FormatNumberForDisplay(snapshot.double_values_.at("L2a")));
+    supaTextLabel.setText("supa =" + FormatNumberForDisplay(snapshot.double_values_.at("supa")));
+    modaTextLabel.setText("moda =" + FormatNumberForDisplay(snapshot.double_values_.at("moda")));
 
-  // Generate plot of model function
-  if(ui->checkBox_showEstimatedPlot->isChecked()) {
-    auto model_distribution_values = GetFunctionsValueOnDomain(target_function_.get(), drawable_domain);
-    QVector<qreal> modelDistributionY = QVector<qreal>(model_distribution_values.begin(),
-                                                       model_distribution_values.end());
-    AddPlot(&modelDistributionY, model_plot_pen_);
-  }
+    UpdateDisplayedValues(snapshot);
+    DrawPlots(snapshot);
 
-  // Generate less elements KDE plot (navy blue)
-  if(ui->checkBox_showEstimationPlot->isChecked()) {
-    vector<double> estimator_values = {};
-    for(auto pt : drawable_domain) {
-      estimator_values.push_back(somke_algorithm->GetValue(pt));
-    }
-    auto estimator_y = QVector<double>(estimator_values.begin(), estimator_values.end());
-    AddPlot(&estimator_y, kde_plot_pen_);
-  }
+    for(const auto &label : plotLabels) label->updateText();
+
+    plot_curves_->Replot();
+  };
+
+  // SOMKE is built on the neurons of its maps, not on clusters, so live view only updates the labels.
+  auto render_live = [&](const EstimatorSnapshot &snapshot) {
+    UpdateDisplayedValues(snapshot);
+
+    for(const auto &label : plotLabels) label->updateText();
+
+    plot_curves_->Replot();
+  };
+
+  RunEstimatorLoop(&snapshot_buffer, estimator_loop, render, render_live);
+
+  frame_export_pipeline_->Flush();
+
+  log("Experiment finished!");
 }
 
 void MainWindow::AddErrorLabelsToPlot(const QVector<QString> &labels, const QVector<double_ptr> &values) {
@@ -2517,28 +2869,19 @@ void MainWindow::AddConstantLabelToPlot(const QString &label) {
   label_vertical_offset_ += label_vertical_offset_step_;
 }
 
-void MainWindow::AddL1ErrorsToSum(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &errors_sums) {
-  for(size_t i = 0; i < errors_calculators.size(); ++i){
-    errors_sums[i] += errors_calculators[i]->CalculateL1Error();
-  }
-}
-
-void MainWindow::AddL2ErrorsToSum(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &errors_sums) {
-  for(size_t i = 0; i < errors_calculators.size(); ++i){
-    errors_sums[i] += errors_calculators[i]->CalculateL2Error();
-  }
-}
-
-void MainWindow::AddSupErrorsToSum(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &errors_sums) {
-  for(size_t i = 0; i < errors_calculators.size(); ++i){
-    errors_sums[i] += errors_calculators[i]->CalculateSupError();
-  }
-}
-
-void MainWindow::AddModErrorsToSum(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &errors_sums) {
-  for(size_t i = 0; i < errors_calculators.size(); ++i){
-    errors_sums[i] += errors_calculators[i]->CalculateModError();
-
+void MainWindow::AddErrorsToSums(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &l1_errors_sums,
+                                 QVector<double> &l2_errors_sums, QVector<double> &sup_errors_sums,
+                                 QVector<double> &mod_errors_sums) {
+  // Sums vectors are filled only for errors that are displayed, so skip the
+  // empty ones.
+  auto errors = ErrorsCalculator::CalculateErrors(
+      std::vector<ErrorsCalculator*>(errors_calculators.begin(), errors_calculators.end()));
+
+  for(int i = 0; i < errors_calculators.size(); ++i){
+    if(i < l1_errors_sums.size()) l1_errors_sums[i] += errors[i].l1_;
+    if(i < l2_errors_sums.size()) l2_errors_sums[i] += errors[i].l2_;
+    if(i < sup_errors_sums.size()) sup_errors_sums[i] += errors[i].sup_;
+    if(i < mod_errors_sums.size()) mod_errors_sums[i] += errors[i].mod_;
   }
 }
 
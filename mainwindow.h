@@ -4,8 +4,11 @@
 #include <QMainWindow>
 #include <QDoubleValidator>
 #include <QStringList>
+#include <QCheckBox>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <functional>
 #include <chrono>
 
 #include "UI/plotLabel.h"
@@ -18,6 +21,7 @@
 #include "KDE/kerneldensityestimator.h"
 #include "KDE/smoothingParameterCounter.h"
 #include "Functions/function.h"
+#include "Functions/cachednormalmixturedensityfunction.h"
 #include "groupingThread/kMedoidsAlgorithm/attributeData.h"
 #include "ClusterKernelWrappers/enhancedClusterKernelAlgorithm.h"
 
@@ -28,6 +32,10 @@
 #include "SOMKEAlgorithm.h"
 
 #include "UI/plot.h"
+#include "UI/frameExportPipeline.h"
+#include "UI/curveDump.h"
+#include "UI/plotCurvesModel.h"
+#include "UI/estimatorSnapshotBuffer.h"
 
 enum class KernelSettingsColumns : int {
   kKernelColumnIndex = 0,
@@ -75,12 +83,29 @@ class MainWindow : public QMainWindow {
     void AddDoubleLabelToPlot(const QString &label, double *value);
     void AddIntLabelToPlot(const QString &label, int *value);
     void AddConstantLabelToPlot(const QString &label);
-    void AddL1ErrorsToSum(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &errors_sums);
-    void AddL2ErrorsToSum(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &errors_sums);
-    void AddSupErrorsToSum(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &errors_sums);
-    void AddModErrorsToSum(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &errors_sums);
+    void AddErrorsToSums(QVector<ErrorsCalculator*> &errors_calculators, QVector<double> &l1_errors_sums,
+                         QVector<double> &l2_errors_sums, QVector<double> &sup_errors_sums,
+                         QVector<double> &mod_errors_sums);
     void AddColorsLegendToPlot();
 
+    std::unique_ptr<FrameExportPipeline> frame_export_pipeline_;
+    void ExportPlotFrame(const QString &image_name, const int &step_number);
+    void ExportContourPlotFrame(const QString &image_name);
+
+    // Experiment loops run on a worker thread, GUI only renders the snapshots they publish.
+    const int kRenderIntervalMs = 30;
+    std::unordered_map<std::string, double> displayed_double_values_ = {};
+    std::unordered_map<std::string, int> displayed_int_values_ = {};
+    void RunEstimatorLoop(EstimatorSnapshotBuffer *snapshot_buffer, const std::function<void()> &estimator_loop,
+                          const std::function<void(const EstimatorSnapshot &)> &render,
+                          const std::function<void(const EstimatorSnapshot &)> &render_live);
+    void SetExperimentControlsEnabled(const bool &enabled);
+    std::shared_ptr<EstimatorSnapshot> CreateSnapshot(const QString &frame_path = "");
+    void AddClustersToSnapshot(DESDA *DESDAAlgorithm, EstimatorSnapshot *snapshot);
+    std::vector<double> GetSnapshotKDEValues(const EstimatorSnapshot &snapshot, kernelDensityEstimator *estimator,
+                                             const bool &should_consider_weights);
+    void DrawLiveCurves(const EstimatorSnapshot &snapshot, kernelDensityEstimator *estimator);
+    void UpdateDisplayedValues(const EstimatorSnapshot &snapshot);
 
   private:
     // Pens for 1d plot
@@ -94,6 +119,11 @@ class MainWindow : public QMainWindow {
     const QPen derivative_plot_pen_ = QPen(QColor(255, 165, 0)); // Orange
     const QPen standardized_derivative_plot_pen_ = QPen(QColor(115, 65, 45)); // Yellow
 
+    // Curves of DESDA dump, in order of the frame. Names match the pens of the offline renderer.
+    const std::vector<std::string> desda_dump_curves_names_ = {
+        "model", "windowed_kde", "kde", "weighted_kde", "enhanced_kde", "rare_elements_kde", "derivative"
+    };
+
     void FillErrorIndicesColors();
 
     QVector<QColor> error_indices_colors = {};
@@ -102,6 +132,10 @@ class MainWindow : public QMainWindow {
     Plot *contour_plot_ = nullptr;
     std::vector<QCPAbstractItem *> lines_on_plot_;
 
+    // Persistent curves of 1D plot
+    std::unique_ptr<PlotCurvesModel> plot_curves_;
+    QVector<double> plot_ranges_ = {};
+
     long long start = 0;
     int screen_generation_frequency_ = 1;
     // Default settings
@@ -143,13 +177,17 @@ class MainWindow : public QMainWindow {
     std::shared_ptr<kernelDensityEstimator> enhanced_kde_;
     vector<std::shared_ptr<vector<double>>> means_, standard_deviations_;
     QStringList kernel_types_;
-    std::shared_ptr<function> target_function_;
-    void DrawPlots(DESDA *DESDAAlgorithm);
-    void DrawPlots(EnhancedClusterKernelAlgorithm *CKAlgorithm);
-    void DrawPlots(KerDEP_CC_WDE *WDEAlgorithm);
-    void DrawPlots(SOMKEAlgorithm *somke_algorithm);
+    std::shared_ptr<cachedNormalMixtureDensityFunction> target_function_;
+    void DrawPlots(const EstimatorSnapshot &snapshot);
+    std::unordered_map<std::string, QCheckBox *> GetCurvesCheckBoxes();
+    std::unordered_set<std::string> GetShownCurvesNames();
+    std::vector<std::vector<double>> GetDrawableDomainPoints();
+    std::vector<double> GetCurveValues(DESDA *DESDAAlgorithm, const std::string &name,
+                                       const std::vector<std::vector<double>> *domain);
+    CurveDumpFrame GenerateCurveDumpFrame(DESDA *DESDAAlgorithm);
     void ClearPlot();
-    void AddPlot(const QVector<qreal> *Y, const QPen &pen);
+    void AddPlot(const std::string &name, const std::vector<double> &Y, const QPen &pen);
+    void RemoveUncommonClustersMarks();
     void ResizePlot();
     unsigned long long MarkUncommonClusters();
     void FillStandardDeviations(
@@ -175,7 +213,7 @@ class MainWindow : public QMainWindow {
         dataParser *parser);
     kernelDensityEstimator *GenerateKernelDensityEstimator(
         int dimensionsNumber);
-    function *GenerateTargetFunction(
+    cachedNormalMixtureDensityFunction *GenerateTargetFunction(
         vector<std::shared_ptr<vector<double>>> *means,
         vector<std::shared_ptr<vector<double>>> *stDevs);
     static int CanAnimationBePerformed(int dimensionsNumber);